@@ -0,0 +1,23 @@
+#include <pthread.h>
+#include "headers/cpuFeatures.h"
+
+static pthread_once_t detection_once = PTHREAD_ONCE_INIT;
+static CpuVectorLevel vector_level = CPU_VECTOR_SCALAR;
+
+static void detectVectorLevel();
+
+CpuVectorLevel cpuGetVectorLevel(){
+    pthread_once(&detection_once, detectVectorLevel);
+    return vector_level;
+}
+
+static void detectVectorLevel(){
+#ifdef HAS_X86_KERNELS
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")){
+        vector_level = CPU_VECTOR_AVX2;
+    } else if(__builtin_cpu_supports("sse2")){
+        vector_level = CPU_VECTOR_SSE2;
+    }
+#endif
+}
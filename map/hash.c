@@ -0,0 +1,11 @@
+#include "headers/hash.h"
+
+#define FNV_PRIME 16777619u
+
+uint32_t hashFnv1a(uint32_t hash, const void *bytes, size_t size){
+    const unsigned char *byte = bytes;
+    for(size_t i = 0; i < size; i++){
+        hash = (hash ^ byte[i]) * FNV_PRIME;
+    }
+    return hash;
+}
@@ -0,0 +1,33 @@
+#ifndef CPU_FEATURES_H_
+#define CPU_FEATURES_H_
+
+/**
+* CPU Feature Detection
+*
+* Detects once per process which vector instructions the CPU supports, so modules with SIMD
+* kernels can pick the widest one. Detection is done under pthread_once, so modules may ask
+* from any thread, at any time.
+*
+* Kernels for x86 are compiled where HAS_X86_KERNELS is defined, each with a target attribute,
+* so the rest of the program does not depend on the instructions they use.
+*/
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAS_X86_KERNELS
+#endif
+
+/** The vector instruction sets kernels are written for, from the narrowest */
+typedef enum CpuVectorLevel_t {
+    CPU_VECTOR_SCALAR,
+    CPU_VECTOR_SSE2,
+    CPU_VECTOR_AVX2
+} CpuVectorLevel;
+
+/**
+* cpuGetVectorLevel: Returns the widest vector instruction set the CPU supports.
+* @return CPU_VECTOR_SCALAR where no x86 kernels are compiled or the CPU supports neither set,
+* 	the widest supported set otherwise.
+*/
+CpuVectorLevel cpuGetVectorLevel();
+
+#endif /* CPU_FEATURES_H_ */
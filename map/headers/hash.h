@@ -0,0 +1,28 @@
+#ifndef HASH_H_
+#define HASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* 32 bit FNV-1a Hash
+*
+* Used for hashing string keys and for the checksums of saved files. A hash is started
+* from FNV_OFFSET_BASIS and may be extended over several byte ranges, which hashes them
+* as if they were one contiguous range.
+*/
+
+/** The hash of no bytes, which every hash starts from */
+#define FNV_OFFSET_BASIS 2166136261u
+
+/**
+* hashFnv1a: Extends a hash over a range of bytes.
+*
+* @param hash - The hash of the bytes before the range, FNV_OFFSET_BASIS for none
+* @param bytes - The bytes to hash. May be NULL if size is 0.
+* @param size - The number of bytes to hash
+* @return The hash of the earlier bytes followed by the range
+*/
+uint32_t hashFnv1a(uint32_t hash, const void *bytes, size_t size);
+
+#endif /* HASH_H_ */
@@ -0,0 +1,163 @@
+#ifndef INT_MAP_H_
+#define INT_MAP_H_
+
+#include <stdbool.h>
+#include "map.h"
+
+/**
+* Int Keyed Map Container
+*
+* Implements a map from int keys to generic data elements as a B+ tree. Every node
+* holds up to INT_MAP_ORDER keys in one cache line, and the keys of a node are searched
+* with SIMD compares (AVX2 or SSE2, chosen at runtime, with a scalar fallback), so a
+* lookup costs about log16(n) cache misses instead of log2(n).
+* The data elements are kept in the leaves, which are linked in key order for ordered
+* scans. Keys are not copied: they are stored by value.
+* The map has an internal iterator for external use, with the same rules as the Map
+* iterator.
+*
+* Removing keys does not merge nodes, so a map which shrank a lot keeps its nodes until
+* it is cleared.
+*
+* The following functions are available:
+*   intMapCreate		- Creates a new empty int map
+*   intMapDestroy		- Deletes an existing int map and frees all resources
+*   intMapGetSize		- Returns the number of keys in an int map
+*   intMapContains		- Returns whether or not a key exists inside the int map
+*   intMapPut		    - Gives a key a given value, overriding the existing one
+*   intMapGet		    - Returns the data paired to a key
+*   intMapRemove		- Removes a key and its data
+*   intMapGetFirst		- Sets the internal iterator to the smallest key and returns it
+*   intMapGetNext		- Advances the internal iterator to the next key and returns it
+*   intMapClear		- Clears the contents of the int map
+* 	 INT_MAP_FOREACH	- A macro for iterating over the int map's keys in order.
+*/
+
+/** The maximal number of keys in a node, 16 ints being one 64 byte cache line */
+#define INT_MAP_ORDER 16
+
+/** Type for defining the int map */
+typedef struct IntMap_t *IntMap;
+
+/**
+* intMapCreate: Allocates a new empty int map.
+*
+* @param copyDataElement - Function pointer to be used for copying data elements into the map.
+* @param freeDataElement - Function pointer to be used for removing data elements from the map.
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new IntMap in case of success.
+*/
+IntMap intMapCreate(copyMapDataElements copyDataElement, freeMapDataElements freeDataElement);
+
+/**
+* intMapDestroy: Deallocates an existing int map, freeing all data elements using the
+* stored free function.
+*
+* @param map - Target map to be deallocated. If map is NULL nothing will be done
+*/
+void intMapDestroy(IntMap map);
+
+/**
+* intMapGetSize: Returns the number of keys in an int map
+* @param map - The map which size is requested
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of keys in the map.
+*/
+int intMapGetSize(IntMap map);
+
+/**
+* intMapContains: Checks if a key exists in the int map.
+*
+* @param map - The map to search in
+* @param key - The key to look for
+* @return
+* 	false - if a NULL was sent or the key was not found.
+* 	true - if the key was found in the map.
+*/
+bool intMapContains(IntMap map, int key);
+
+/**
+* intMapPut: Gives a key a copy of a given data element. If the key exists, its old
+* data element is freed using the free function given at initialization.
+* Iterator's value is undefined after this operation.
+*
+* @param map - The map to put into
+* @param key - The key to assign
+* @param dataElement - The data element to copy into the map
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map or dataElement
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS the data element had been inserted successfully
+*/
+MapResult intMapPut(IntMap map, int key, MapDataElement dataElement);
+
+/**
+* intMapGet: Returns the data element paired with a key.
+* Iterator status unchanged
+*
+* @param map - The map to search in
+* @param key - The key to look for
+* @return
+* 	NULL if a NULL pointer was sent or the map does not contain the key.
+* 	The data element paired with the key otherwise.
+*/
+MapDataElement intMapGet(IntMap map, int key);
+
+/**
+* intMapRemove: Removes a key and frees its data element using the free function given
+* at initialization.
+* Iterator's value is undefined after this operation.
+*
+* @param map - The map to remove from
+* @param key - The key to remove
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map
+* 	MAP_ITEM_DOES_NOT_EXIST if the key does not exist in the map
+* 	MAP_SUCCESS the key had been removed successfully
+*/
+MapResult intMapRemove(IntMap map, int key);
+
+/**
+* intMapGetFirst: Sets the internal iterator to the smallest key in the map.
+*
+* @param map - The map to iterate over
+* @param key - The smallest key is stored here. Must be non-NULL.
+* @return
+* 	false if a NULL was sent or the map is empty.
+* 	true otherwise.
+*/
+bool intMapGetFirst(IntMap map, int *key);
+
+/**
+* intMapGetNext: Advances the internal iterator to the next key in order.
+*
+* @param map - The map to iterate over
+* @param key - The next key is stored here. Must be non-NULL.
+* @return
+* 	false if reached the end of the map, the iterator is at an invalid state or a NULL was sent.
+* 	true otherwise.
+*/
+bool intMapGetNext(IntMap map, int *key);
+
+/**
+* intMapClear: Removes all keys from target map, freeing the data elements using the
+* stored free function.
+* @param map - Target map
+* @return
+* 	MAP_NULL_ARGUMENT - if a NULL pointer was sent.
+* 	MAP_SUCCESS - Otherwise.
+*/
+MapResult intMapClear(IntMap map);
+
+/*!
+* Macro for iterating over the keys of an int map, in order.
+* Declares a new int iterator for the loop.
+*/
+#define INT_MAP_FOREACH(iterator, map) \
+    for(int iterator = 0, iterator##_found = intMapGetFirst(map, &iterator) ; \
+        iterator##_found ;\
+        iterator##_found = intMapGetNext(map, &iterator))
+
+#endif /* INT_MAP_H_ */
@@ -2,6 +2,7 @@
 #define MAP_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 
 /**
 * Generic Map Container
@@ -13,6 +14,10 @@
 *
 * The following functions are available:
 *   mapCreate		- Creates a new empty map
+*   mapCreateBounded - Creates a new empty map which holds a limited number of
+*                    elements, evicting the least recently used ones
+*   mapCreateStringKeys - Creates a new empty map keyed by strings, which caches
+*                    the hash and length of every key for faster comparisons
 *   mapDestroy		- Deletes an existing map and frees all resources
 *   mapCopy		- Copies an existing map
 *   mapGetSize		- Returns the size of a given map
@@ -32,6 +37,20 @@
 *   				  returns it.
 *	 mapClear		- Clears the contents of the map. Frees all the elements of
 *	 				  the map using the free function.
+*   mapGetByRank	- Returns the key element at a given position in key order.
+*					  Iterator status unchanged
+*   mapRankOf		- Returns the number of key elements smaller than a given key.
+*					  Iterator status unchanged
+*   mapParallelForEach - Applies a function on every pair of elements, using
+*                    several threads. Iterator status unchanged
+*   mapParallelReduce - Folds all the pairs of elements into accumulators, using
+*                    several threads. Iterator status unchanged
+*   mapDiff		- Reports the keys added, removed and changed between two maps.
+*					  Iterator status unchanged
+*   mapCompact		- Moves all the nodes of the map into one block of memory, in key order.
+*					  Iterator status unchanged
+*   mapGetMemoryUsage - Reports the bytes used by the map's structure, keys and values.
+*					  Iterator status unchanged
 * 	 MAP_FOREACH	- A macro for iterating over the map's elements.
 */
 
@@ -75,6 +94,34 @@ typedef void(*freeMapKeyElements)(MapKeyElement);
 */
 typedef int(*compareMapKeyElements)(MapKeyElement, MapKeyElement);
 
+/** Type of function applied on every pair of key and data elements, with a user context */
+typedef void(*applyOnMapElements)(MapKeyElement, MapDataElement, void *);
+
+/** Type of function which folds a pair of key and data elements into an accumulator */
+typedef void(*accumulateMapElements)(void *, MapKeyElement, MapDataElement);
+
+/** Type of function which folds the second accumulator into the first one */
+typedef void(*combineMapAccumulators)(void *, void *);
+
+/** Type of function applied on a key whose data differs between two maps: key, old data, new data and a user context */
+typedef void(*applyOnChangedMapElements)(MapKeyElement, MapDataElement, MapDataElement, void *);
+
+/** Type of function used to decide whether two data elements are equal */
+typedef bool(*equalMapDataElements)(MapDataElement, MapDataElement);
+
+/** Type of function returning the number of bytes a key element uses, including memory it owns */
+typedef size_t(*sizeOfMapKeyElements)(MapKeyElement);
+
+/** Type of function returning the number of bytes a data element uses, including memory it owns */
+typedef size_t(*sizeOfMapDataElements)(MapDataElement);
+
+/** Bytes held by a map, as reported by mapGetMemoryUsage */
+typedef struct MapMemoryUsage_t {
+    size_t structure;
+    size_t keys;
+    size_t values;
+} MapMemoryUsage;
+
 /**
 * mapCreate: Allocates a new empty map.
 *
@@ -98,6 +145,49 @@ Map mapCreate(copyMapDataElements copyDataElement,
               freeMapKeyElements freeKeyElement,
               compareMapKeyElements compareKeyElements);
 
+/**
+* mapCreateBounded: Allocates a new empty map which holds at most maxEntries pairs of
+* (key,data) elements. When a new key is put into a full map, an element which was not
+* recently used is evicted first and freed using the free functions.
+* Recency is approximated with the CLOCK policy: mapGet and mapPut only mark an element
+* as used, and eviction skips (and unmarks) marked elements, so a lookup costs the same
+* as in an unbounded map.
+*
+* @param maxEntries - The maximal number of elements in the map. Must be positive.
+* @param copyDataElement - Same as in mapCreate
+* @param copyKeyElement - Same as in mapCreate
+* @param freeDataElement - Same as in mapCreate, also used for evicted elements
+* @param freeKeyElement - Same as in mapCreate, also used for evicted elements
+* @param compareKeyElements - Same as in mapCreate
+* @return
+* 	NULL - if one of the parameters is NULL, maxEntries is not positive or allocations failed.
+* 	A new Map in case of success.
+*/
+Map mapCreateBounded(int maxEntries,
+                     copyMapDataElements copyDataElement,
+                     copyMapKeyElements copyKeyElement,
+                     freeMapDataElements freeDataElement,
+                     freeMapKeyElements freeKeyElement,
+                     compareMapKeyElements compareKeyElements);
+
+/**
+* mapCreateStringKeys: Allocates a new empty map whose keys are null terminated strings.
+* The map copies, frees and compares the keys itself: every key is stored with its hash
+* and length, so two keys are only compared character by character when both are equal,
+* and looking a key up hashes it once instead of running strcmp at every tree level.
+* Keys are therefore ordered by hash rather than alphabetically, and iteration, ranks
+* and mapDiff (between two such maps) follow that order.
+* Keys are passed to the map and returned from it as plain strings (char *), and the
+* callbacks of mapParallelForEach, mapParallelReduce and mapDiff receive them as strings.
+*
+* @param copyDataElement - Same as in mapCreate
+* @param freeDataElement - Same as in mapCreate
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new Map in case of success.
+*/
+Map mapCreateStringKeys(copyMapDataElements copyDataElement, freeMapDataElements freeDataElement);
+
 /**
 * mapDestroy: Deallocates an existing map. Clears all elements by using the
 * stored free functions.
@@ -156,6 +246,8 @@ bool mapContains(Map map, MapKeyElement element);
 * 	MAP_OUT_OF_MEMORY if an allocation failed (Meaning the function for copying
 * 	an element failed)
 * 	MAP_SUCCESS the paired elements had been inserted successfully
+* 	If the map was created with mapCreateBounded and is full, inserting a new key evicts
+* 	another element first.
 */
 MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement);
 
@@ -230,6 +322,135 @@ MapKeyElement mapGetNext(Map map);
 */
 MapResult mapClear(Map map);
 
+/**
+*	mapGetByRank: Returns the key element at a given position in the order defined by
+*	the key compare function, in O(log n).
+*	Iterator status unchanged
+*
+* @param map - The map to search in
+* @param rank - The zero based position of the requested key element, 0 being the smallest key
+* @return
+* 	NULL if a NULL pointer was sent, rank is out of range or a memory allocation failed.
+* 	A copy of the key element at the given position otherwise. The copy should be freed
+* 	by the caller, same as the keys returned by mapGetFirst and mapGetNext.
+*/
+MapKeyElement mapGetByRank(Map map, int rank);
+
+/**
+*	mapRankOf: Returns the number of key elements in the map which are smaller than the
+*	given key element, in O(log n). The given key does not need to be in the map. If it is,
+*	the result is its position as accepted by mapGetByRank.
+*	Iterator status unchanged
+*
+* @param map - The map to search in
+* @param keyElement - The key element to rank
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	The number of smaller key elements otherwise.
+*/
+int mapRankOf(Map map, MapKeyElement keyElement);
+
+/**
+*	mapParallelForEach: Calls a function on every pair of key and data elements in the map.
+*	The map is split into up to threads contiguous ranges in key order, and each range is
+*	scanned on its own thread (the first one on the calling thread). Elements are passed
+*	as stored in the map, without copying.
+*	The map must not be changed while the scan is running. The function may read the map
+*	(e.g. with mapGet, unless the map is bounded) and must synchronize its own writes to context.
+*	Iterator status unchanged
+*
+* @param map - The map to scan
+* @param apply - The function to call, with the key element, the data element and context
+* @param context - A user pointer passed to every call of apply
+* @param threads - The maximal number of threads to use. 1 or less scans on the calling thread.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map or apply
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS otherwise
+*/
+MapResult mapParallelForEach(Map map, applyOnMapElements apply, void *context, int threads);
+
+/**
+*	mapParallelReduce: Folds every pair of key and data elements in the map into accumulators.
+*	The map is split in the same way as in mapParallelForEach. The i-th range in key order
+*	is folded into the i-th accumulator, so no synchronization is needed. If the map has
+*	fewer elements than threads, the trailing accumulators are left untouched.
+*	Once all ranges are done, if combine is not NULL, the accumulators are combined in order
+*	into the first one.
+*	Iterator status unchanged
+*
+* @param map - The map to scan
+* @param accumulate - The function folding a pair of elements into an accumulator
+* @param combine - The function folding one accumulator into another, or NULL to keep the
+* 		accumulator of every range (e.g. when the ranges need to be output in order)
+* @param accumulators - An array of max(threads, 1) accumulators, each initialized by the caller
+* @param accumulatorSize - The size in bytes of a single accumulator
+* @param threads - The maximal number of threads to use
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map, accumulate or accumulators
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS otherwise
+*/
+MapResult mapParallelReduce(Map map, accumulateMapElements accumulate, combineMapAccumulators combine,
+                            void *accumulators, size_t accumulatorSize, int threads);
+
+/**
+*	mapDiff: Compares two versions of a map in a single merged pass over their keys, in
+*	O(n + m). Both maps must order their keys with the same comparison function.
+*	Elements are passed to the callbacks as stored in the maps, without copying.
+*	Iterator status unchanged for both maps
+*
+* @param before - The older version of the map
+* @param after - The newer version of the map
+* @param onAdded - Called with every pair of elements whose key is only in after. May be NULL.
+* @param onRemoved - Called with every pair of elements whose key is only in before. May be NULL.
+* @param onChanged - Called with every key found in both maps whose data elements are not equal,
+* 		with the data element of before and then the data element of after. May be NULL.
+* @param dataEquals - Function used to compare the data elements of a key found in both maps.
+* 		Must be non-NULL if onChanged is.
+* @param context - A user pointer passed to every callback
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as one of the maps, or onChanged without dataEquals
+* 	MAP_SUCCESS otherwise
+*/
+MapResult mapDiff(Map before, Map after, applyOnMapElements onAdded, applyOnMapElements onRemoved,
+                  applyOnChangedMapElements onChanged, equalMapDataElements dataEquals, void *context);
+
+/**
+*	mapCompact: Moves all the nodes of a map into a single newly allocated block, laid out in
+*	key order, and frees the blocks they occupied. Meant for long-lived maps whose nodes got
+*	scattered by many insertions and removals: afterwards, iterating over the map reads
+*	memory sequentially. Keys and data elements are not moved.
+*	The map must not be accessed by other threads while it is compacted.
+*	Iterator status unchanged
+*
+* @param map - The map to compact
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map
+* 	MAP_OUT_OF_MEMORY if the new block could not be allocated, in which case the map is unchanged
+* 	MAP_SUCCESS otherwise
+*/
+MapResult mapCompact(Map map);
+
+/**
+*	mapGetMemoryUsage: Reports how many bytes a map holds. The structure count covers the map
+*	itself and all of its node blocks, including nodes freed for reuse. Keys and values are
+*	opaque to the map, so their sizes are summed through the given functions.
+*	Allocator overhead is not counted.
+*	Iterator status unchanged
+*
+* @param map - The map to measure
+* @param keySize - Returns the bytes used by a key element. If NULL, keys are not counted.
+* 		Maps created with mapCreateStringKeys count their keys themselves and ignore it.
+* @param dataSize - Returns the bytes used by a data element. If NULL, values are not counted.
+* @param usage - The byte counts are stored here. Must be non-NULL.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map or usage
+* 	MAP_SUCCESS otherwise
+*/
+MapResult mapGetMemoryUsage(Map map, sizeOfMapKeyElements keySize, sizeOfMapDataElements dataSize,
+                            MapMemoryUsage *usage);
+
 /*!
 * Macro for iterating over a map.
 * Declares a new iterator for the loop.
@@ -0,0 +1,281 @@
+#ifndef MULTIMAP_H_
+#define MULTIMAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+* Generic Multi Map Container
+*
+* Implements a map in which every key holds a list of values. The values of a key
+* are stored contiguously, in insertion order until values are removed.
+* Keys are kept in the order defined by a compare function, on the same tree as Map.
+* The multi map has an internal iterator over its keys, with the same rules as the
+* Map iterator.
+*
+* The following functions are available:
+*   multiMapCreate		- Creates a new empty multi map
+*   multiMapDestroy		- Deletes an existing multi map and frees all resources
+*   multiMapGetSize		- Returns the number of keys in a multi map
+*   multiMapContains		- Returns whether or not a key has values in the multi map
+*   multiMapAppend		- Adds a value to the list of a key, in O(log n) plus O(1) amortized
+*   multiMapGetValues		- Returns the contiguous list of values of a key, in O(log n)
+*   multiMapRemoveValueAt	- Removes a value of a key by its index in the list, in O(log n)
+*   multiMapRemoveLastValue	- Removes the value appended last to a key, in O(log n)
+*   multiMapRemoveValue	- Removes a value of a key which equals a given value, in O(log n + k)
+*   					  for a key with k values
+*   multiMapRemoveKey		- Removes a key with all of its values
+*
+* Here n is the number of keys, and every operation also copies or frees the values it adds or
+* removes. The first value of a key allocates its list, the later ones only grow it.
+*   multiMapGetFirst		- Sets the internal iterator to the first key and returns it
+*   multiMapGetNext		- Advances the internal iterator to the next key and returns it
+*   multiMapClear		- Clears the contents of the multi map
+*   multiMapGetMemoryUsage	- Returns the bytes used by the multi map, its keys and values
+* 	 MULTIMAP_FOREACH		- A macro for iterating over the multi map's keys.
+*/
+
+/** Type for defining the multi map */
+typedef struct MultiMap_t *MultiMap;
+
+/** Type used for returning error codes from multi map functions */
+typedef enum MultiMapResult_t {
+    MULTIMAP_SUCCESS,
+    MULTIMAP_OUT_OF_MEMORY,
+    MULTIMAP_NULL_ARGUMENT,
+    MULTIMAP_ITEM_DOES_NOT_EXIST
+} MultiMapResult;
+
+/** Key element data type for multi map container */
+typedef void *MultiMapKeyElement;
+
+/** Value element data type for multi map container */
+typedef void *MultiMapValueElement;
+
+/** Type of function for copying a key element of the multi map */
+typedef MultiMapKeyElement(*copyMultiMapKeyElements)(MultiMapKeyElement);
+
+/** Type of function for copying a value element of the multi map */
+typedef MultiMapValueElement(*copyMultiMapValueElements)(MultiMapValueElement);
+
+/** Type of function for deallocating a key element of the multi map */
+typedef void(*freeMultiMapKeyElements)(MultiMapKeyElement);
+
+/** Type of function for deallocating a value element of the multi map */
+typedef void(*freeMultiMapValueElements)(MultiMapValueElement);
+
+/**
+* Type of function used by the multi map to order its key elements.
+* This function should return:
+* 		A positive integer if the first element is greater;
+* 		0 if they're equal;
+*		A negative integer if the second element is greater.
+*/
+typedef int(*compareMultiMapKeyElements)(MultiMapKeyElement, MultiMapKeyElement);
+
+/** Type of function used by the multi map to find a value: returns true if the values are equal */
+typedef bool(*equalMultiMapValueElements)(MultiMapValueElement, MultiMapValueElement);
+
+/** Type of function returning the number of bytes a key element uses, including memory it owns */
+typedef size_t(*sizeOfMultiMapKeyElements)(MultiMapKeyElement);
+
+/** Type of function returning the number of bytes a value element uses, including memory it owns */
+typedef size_t(*sizeOfMultiMapValueElements)(MultiMapValueElement);
+
+/**
+* multiMapCreate: Allocates a new empty multi map.
+*
+* @param copyKeyElement - Function pointer to be used for copying key elements into the multi map.
+* @param freeKeyElement - Function pointer to be used for removing key elements from the multi map.
+* @param compareKeyElements - Function pointer to be used for comparing key elements.
+* @param copyValueElement - Function pointer to be used for copying value elements into the multi map.
+* @param freeValueElement - Function pointer to be used for removing value elements from the multi map.
+* @param equalValueElements - Function pointer to be used for finding value elements on removal.
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new MultiMap in case of success.
+*/
+MultiMap multiMapCreate(copyMultiMapKeyElements copyKeyElement,
+                        freeMultiMapKeyElements freeKeyElement,
+                        compareMultiMapKeyElements compareKeyElements,
+                        copyMultiMapValueElements copyValueElement,
+                        freeMultiMapValueElements freeValueElement,
+                        equalMultiMapValueElements equalValueElements);
+
+/**
+* multiMapDestroy: Deallocates an existing multi map, freeing all keys and values using
+* the stored free functions.
+*
+* @param multiMap - Target multi map to be deallocated. If NULL nothing will be done
+*/
+void multiMapDestroy(MultiMap multiMap);
+
+/**
+* multiMapGetSize: Returns the number of keys in a multi map
+* @param multiMap - The multi map which size is requested
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of keys which have at least one value.
+*/
+int multiMapGetSize(MultiMap multiMap);
+
+/**
+* multiMapContains: Checks if a key has at least one value in the multi map.
+*
+* @param multiMap - The multi map to search in
+* @param keyElement - The key element to look for
+* @return
+* 	false - if one or more of the inputs is null, or if the key element was not found.
+* 	true - if the key element was found.
+*/
+bool multiMapContains(MultiMap multiMap, MultiMapKeyElement keyElement);
+
+/**
+* multiMapAppend: Adds a copy of a value to the end of the list of a key. The key is
+* added to the multi map if it has no values yet.
+* Iterator's value is undefined after this operation.
+*
+* @param multiMap - The multi map to add to
+* @param keyElement - The key element to add the value to
+* @param valueElement - The value element to add
+* @return
+* 	MULTIMAP_NULL_ARGUMENT if a NULL was sent as one of the parameters
+* 	MULTIMAP_OUT_OF_MEMORY if an allocation failed
+* 	MULTIMAP_SUCCESS the value had been added successfully
+*/
+MultiMapResult multiMapAppend(MultiMap multiMap, MultiMapKeyElement keyElement, MultiMapValueElement valueElement);
+
+/**
+* multiMapGetValues: Returns the list of values of a key, as a contiguous array.
+* The array and its values still belong to the multi map, and are valid until the next
+* change of the key's values.
+* Iterator status unchanged
+*
+* @param multiMap - The multi map to search in
+* @param keyElement - The key element whose values are requested
+* @param valuesCount - The number of values in the returned array is stored here
+* 		(0 if the key was not found or a NULL was sent). Must be non-NULL.
+* @return
+* 	NULL if a NULL pointer was sent or the key has no values.
+* 	The array of the key's values otherwise.
+*/
+MultiMapValueElement *multiMapGetValues(MultiMap multiMap, MultiMapKeyElement keyElement, int *valuesCount);
+
+/**
+* multiMapRemoveValueAt: Removes the value at a given index in the list of a key and frees
+* it. The last value of the list takes its place, so the order of the list is not kept.
+* If the key is left without values, it is removed as well.
+* Iterator's value is undefined after this operation.
+*
+* @param multiMap - The multi map to remove from
+* @param keyElement - The key element to remove the value from
+* @param index - The index of the value, as in the array returned by multiMapGetValues
+* @return
+* 	MULTIMAP_NULL_ARGUMENT if a NULL was sent as multiMap or keyElement
+* 	MULTIMAP_ITEM_DOES_NOT_EXIST if the key does not exist or the index is out of range
+* 	MULTIMAP_SUCCESS the value had been removed successfully
+*/
+MultiMapResult multiMapRemoveValueAt(MultiMap multiMap, MultiMapKeyElement keyElement, int index);
+
+/**
+* multiMapRemoveLastValue: Removes the value at the end of the list of a key, in the same
+* way as multiMapRemoveValueAt. As long as no value of the key was removed since, this is
+* the value appended last, so it undoes a multiMapAppend without searching for the value.
+* Iterator's value is undefined after this operation.
+*
+* @param multiMap - The multi map to remove from
+* @param keyElement - The key element to remove the value from
+* @return
+* 	MULTIMAP_NULL_ARGUMENT if a NULL was sent as one of the parameters
+* 	MULTIMAP_ITEM_DOES_NOT_EXIST if the key does not exist
+* 	MULTIMAP_SUCCESS the value had been removed successfully
+*/
+MultiMapResult multiMapRemoveLastValue(MultiMap multiMap, MultiMapKeyElement keyElement);
+
+/**
+* multiMapRemoveValue: Removes the first value in the list of a key which equals a given
+* value, in the same way as multiMapRemoveValueAt. Finding the value is linear in the
+* number of values of the key, so a value whose index is known should be removed with
+* multiMapRemoveValueAt, and a value just appended with multiMapRemoveLastValue.
+* Iterator's value is undefined after this operation.
+*
+* @param multiMap - The multi map to remove from
+* @param keyElement - The key element to remove the value from
+* @param valueElement - The value element to look for, compared using the equality function
+* @return
+* 	MULTIMAP_NULL_ARGUMENT if a NULL was sent as one of the parameters
+* 	MULTIMAP_ITEM_DOES_NOT_EXIST if the key or an equal value does not exist
+* 	MULTIMAP_SUCCESS the value had been removed successfully
+*/
+MultiMapResult multiMapRemoveValue(MultiMap multiMap, MultiMapKeyElement keyElement,
+                                   MultiMapValueElement valueElement);
+
+/**
+* multiMapRemoveKey: Removes a key and all of its values from the multi map, freeing them.
+* Iterator's value is undefined after this operation.
+*
+* @param multiMap - The multi map to remove from
+* @param keyElement - The key element to remove
+* @return
+* 	MULTIMAP_NULL_ARGUMENT if a NULL was sent as one of the parameters
+* 	MULTIMAP_ITEM_DOES_NOT_EXIST if the key does not exist
+* 	MULTIMAP_SUCCESS the key had been removed successfully
+*/
+MultiMapResult multiMapRemoveKey(MultiMap multiMap, MultiMapKeyElement keyElement);
+
+/**
+* multiMapGetFirst: Sets the internal iterator to the first key element and returns it.
+*
+* @param multiMap - The multi map to iterate over
+* @return
+* 	NULL if a NULL pointer was sent or the multi map is empty.
+* 	A copy of the first key element otherwise, to be freed by the caller.
+*/
+MultiMapKeyElement multiMapGetFirst(MultiMap multiMap);
+
+/**
+* multiMapGetNext: Advances the internal iterator to the next key element and returns it.
+*
+* @param multiMap - The multi map to iterate over
+* @return
+* 	NULL if reached the end, the iterator is at an invalid state or a NULL sent as argument.
+* 	A copy of the next key element otherwise, to be freed by the caller.
+*/
+MultiMapKeyElement multiMapGetNext(MultiMap multiMap);
+
+/**
+* multiMapClear: Removes all keys and values from target multi map, freeing them.
+* @param multiMap - Target multi map
+* @return
+* 	MULTIMAP_NULL_ARGUMENT - if a NULL pointer was sent.
+* 	MULTIMAP_SUCCESS - Otherwise.
+*/
+MultiMapResult multiMapClear(MultiMap multiMap);
+
+/**
+* multiMapGetMemoryUsage: Returns the bytes held by a multi map: its keys counted as
+* mapGetMemoryUsage counts them, and every value list by its capacity.
+* Allocator overhead is not counted.
+* Iterator status unchanged
+*
+* @param multiMap - The multi map to measure
+* @param keySize - Returns the bytes used by a key element. If NULL, keys are not counted.
+* @param valueSize - Returns the bytes used by a value element. If NULL, values are not counted,
+* 		but the lists holding them still are.
+* @return
+* 	0 if a NULL was sent as multiMap.
+* 	The bytes of the multi map's structure, keys and values otherwise.
+*/
+size_t multiMapGetMemoryUsage(MultiMap multiMap, sizeOfMultiMapKeyElements keySize,
+                              sizeOfMultiMapValueElements valueSize);
+
+/*!
+* Macro for iterating over the keys of a multi map.
+* Declares a new iterator for the loop.
+*/
+#define MULTIMAP_FOREACH(type, iterator, multiMap) \
+    for(type iterator = (type) multiMapGetFirst(multiMap) ; \
+        iterator ;\
+        iterator = multiMapGetNext(multiMap))
+
+#endif /* MULTIMAP_H_ */
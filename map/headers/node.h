@@ -5,9 +5,40 @@
 #include "map.h"
 #define EX1_LINKEDLIST_H
 
+#define NODES_PER_BLOCK 16
+
 typedef struct node_t *Node;
 
-Node createEmptyNode();
+typedef struct node_pool_t *NodePool;
+
+NodePool createNodePool();
+
+void destroyNodePool(NodePool pool);
+
+// Frees every block of the pool at once, invalidating all of its nodes
+void clearNodePool(NodePool pool);
+
+// Bytes allocated by the pool, free nodes included
+size_t getNodePoolMemory(NodePool pool);
+
+Node allocateNode(NodePool pool);
+
+void releaseNode(NodePool pool, Node node);
+
+// Adds one contiguous block of count nodes to the pool, handed out in address order before any other node
+bool reserveNodes(NodePool pool, int count);
+
+/*
+ * Relocation moves nodes to another pool: relocateNode copies a node, leaving a forwarding address in the
+ * original. Once every linked node is relocated, resolveRelocatedLinks redirects the links of each copy, and
+ * getRelocatedNode finds the copy of an original. The original nodes are unusable afterwards.
+ * The target pool must have free nodes reserved for all the relocated nodes.
+ */
+Node relocateNode(NodePool pool, Node node);
+
+void resolveRelocatedLinks(Node node);
+
+Node getRelocatedNode(Node node);
 
 MapKeyElement getKey(Node node);
 
@@ -21,4 +52,24 @@ Node getNext(Node node);
 
 void setNext(Node setTo, Node nextNode);
 
+Node getLeft(Node node);
+
+void setLeft(Node setTo, Node leftNode);
+
+Node getRight(Node node);
+
+void setRight(Node setTo, Node rightNode);
+
+unsigned int getPriority(Node node);
+
+void setPriority(Node node, unsigned int priority);
+
+int getSubtreeSize(Node node);
+
+void updateSubtreeSize(Node node);
+
+bool isReferenced(Node node);
+
+void setReferenced(Node node, bool referenced);
+
 #endif //EX1_LINKEDLIST_H
@@ -0,0 +1,190 @@
+#ifndef PRIORITY_QUEUE_H_
+#define PRIORITY_QUEUE_H_
+
+#include <stdbool.h>
+
+/**
+* Generic Indexed Priority Queue Container
+*
+* Implements a binary heap of elements. Every element pushed into the queue
+* gets a handle, which stays valid until the element is popped or removed and
+* allows changing the element's priority in place.
+*
+* The following functions are available:
+*   pqCreate		- Creates a new empty priority queue
+*   pqDestroy		- Deletes an existing priority queue and frees all resources
+*   pqGetSize		- Returns the number of elements in a priority queue
+*   pqPush		    - Inserts a copy of an element and returns its handle
+*   pqPeek		    - Returns the element with the highest priority
+*   pqPeekHandle	- Returns the handle of the element with the highest priority
+*   pqPop		    - Removes the element with the highest priority
+*   pqGet		    - Returns the element of a given handle
+*   pqUpdateKey	- Replaces the element of a given handle, moving it according
+*   				  to its new priority
+*   pqRemove		- Removes the element of a given handle
+*   pqClear		- Removes all the elements of a priority queue
+*/
+
+/** Type for defining the priority queue */
+typedef struct PriorityQueue_t *PriorityQueue;
+
+/** Type used for returning error codes from priority queue functions */
+typedef enum PriorityQueueResult_t {
+    PQ_SUCCESS,
+    PQ_OUT_OF_MEMORY,
+    PQ_NULL_ARGUMENT,
+    PQ_ITEM_DOES_NOT_EXIST
+} PriorityQueueResult;
+
+/** Element data type for priority queue container */
+typedef void *PQElement;
+
+/** Handle of an element in a priority queue */
+typedef int PQHandle;
+
+/** Value returned in place of a handle when no element exists */
+#define PQ_INVALID_HANDLE (-1)
+
+/** Type of function for copying an element of the priority queue */
+typedef PQElement(*copyPQElements)(PQElement);
+
+/** Type of function for deallocating an element of the priority queue */
+typedef void(*freePQElements)(PQElement);
+
+/**
+* Type of function used by the priority queue to order its elements.
+* This function should return:
+* 		A positive integer if the first element has a higher priority;
+* 		0 if their priorities are equal;
+*		A negative integer if the second element has a higher priority.
+*/
+typedef int(*comparePQElementPriorities)(PQElement, PQElement);
+
+/**
+* pqCreate: Allocates a new empty priority queue.
+*
+* @param copyElement - Function pointer to be used for copying elements into the queue.
+* @param freeElement - Function pointer to be used for removing elements from the queue.
+* @param comparePriorities - Function pointer to be used for ordering the elements.
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new PriorityQueue in case of success.
+*/
+PriorityQueue pqCreate(copyPQElements copyElement, freePQElements freeElement,
+                       comparePQElementPriorities comparePriorities);
+
+/**
+* pqDestroy: Deallocates an existing priority queue. Clears all elements by using the
+* stored free function.
+*
+* @param queue - Target queue to be deallocated. If queue is NULL nothing will be done
+*/
+void pqDestroy(PriorityQueue queue);
+
+/**
+* pqGetSize: Returns the number of elements in a priority queue
+* @param queue - The queue which size is requested
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of elements in the queue.
+*/
+int pqGetSize(PriorityQueue queue);
+
+/**
+* pqPush: Inserts a copy of an element into the priority queue, in O(log n).
+*
+* @param queue - The queue to insert into
+* @param element - The element to insert. A copy of the element is inserted, as supplied
+* 		by the copying function given at initialization.
+* @param handle - If not NULL, the handle of the inserted element is stored here.
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as queue or element
+* 	PQ_OUT_OF_MEMORY if an allocation failed
+* 	PQ_SUCCESS the element had been inserted successfully
+*/
+PriorityQueueResult pqPush(PriorityQueue queue, PQElement element, PQHandle *handle);
+
+/**
+* pqPeek: Returns the element with the highest priority, in O(1).
+*
+* @param queue - The queue to look in
+* @return
+* 	NULL if a NULL pointer was sent or the queue is empty.
+* 	The element with the highest priority otherwise. The element still belongs to the queue.
+*/
+PQElement pqPeek(PriorityQueue queue);
+
+/**
+* pqPeekHandle: Returns the handle of the element with the highest priority, in O(1).
+*
+* @param queue - The queue to look in
+* @return
+* 	PQ_INVALID_HANDLE if a NULL pointer was sent or the queue is empty.
+* 	The handle of the element with the highest priority otherwise.
+*/
+PQHandle pqPeekHandle(PriorityQueue queue);
+
+/**
+* pqPop: Removes the element with the highest priority and frees it using the free
+* function given at initialization, in O(log n). Its handle becomes invalid.
+*
+* @param queue - The queue to remove from
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as queue
+* 	PQ_ITEM_DOES_NOT_EXIST if the queue is empty
+* 	PQ_SUCCESS the element had been removed successfully
+*/
+PriorityQueueResult pqPop(PriorityQueue queue);
+
+/**
+* pqGet: Returns the element of a given handle, in O(1).
+*
+* @param queue - The queue to look in
+* @param handle - A handle returned by pqPush
+* @return
+* 	NULL if a NULL pointer was sent or the handle is not valid.
+* 	The element of the handle otherwise. The element still belongs to the queue.
+*/
+PQElement pqGet(PriorityQueue queue, PQHandle handle);
+
+/**
+* pqUpdateKey: Replaces the element of a given handle with a copy of a new element, and
+* moves it according to its new priority, in O(log n). The old element is freed using the
+* free function given at initialization. The handle stays valid.
+*
+* @param queue - The queue holding the element
+* @param handle - A handle returned by pqPush
+* @param element - The new element
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as queue or element
+* 	PQ_ITEM_DOES_NOT_EXIST if the handle is not valid
+* 	PQ_OUT_OF_MEMORY if an allocation failed, in which case the queue is unchanged
+* 	PQ_SUCCESS the element had been replaced successfully
+*/
+PriorityQueueResult pqUpdateKey(PriorityQueue queue, PQHandle handle, PQElement element);
+
+/**
+* pqRemove: Removes the element of a given handle and frees it using the free function
+* given at initialization, in O(log n). The handle becomes invalid.
+*
+* @param queue - The queue holding the element
+* @param handle - A handle returned by pqPush
+* @return
+* 	PQ_NULL_ARGUMENT if a NULL was sent as queue
+* 	PQ_ITEM_DOES_NOT_EXIST if the handle is not valid
+* 	PQ_SUCCESS the element had been removed successfully
+*/
+PriorityQueueResult pqRemove(PriorityQueue queue, PQHandle handle);
+
+/**
+* pqClear: Removes all the elements of the queue, freeing them using the free function
+* given at initialization. All handles become invalid.
+*
+* @param queue - Target queue to remove all elements from.
+* @return
+* 	PQ_NULL_ARGUMENT - if a NULL pointer was sent.
+* 	PQ_SUCCESS - Otherwise.
+*/
+PriorityQueueResult pqClear(PriorityQueue queue);
+
+#endif /* PRIORITY_QUEUE_H_ */
@@ -0,0 +1,252 @@
+#ifndef SET_H_
+#define SET_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+* Generic Ordered Set Container
+*
+* Implements a set of elements, kept in the order defined by a compare function.
+* The set is built on the same tree as Map, but stores no data element: the
+* elements are the map's keys, and no data is copied, freed or allocated for them.
+* The set has an internal iterator for external use, with the same rules as the
+* Map iterator.
+*
+* The following functions are available:
+*   setCreate		- Creates a new empty set
+*   setDestroy		- Deletes an existing set and frees all resources
+*   setCopy		- Copies an existing set
+*   setGetSize		- Returns the size of a given set
+*   setContains	- Returns whether or not an element exists inside the set
+*   setAdd		    - Adds a copy of an element to the set
+*   setRemove		- Removes an element from the set
+*   setGetFirst	- Sets the internal iterator to the smallest element, and returns it
+*   setGetNext		- Advances the internal iterator to the next element and returns it
+*   setGetByRank	- Returns the element at a given position in the set's order
+*   setRankOf		- Returns the number of elements smaller than a given element
+*   setClear		- Clears the contents of the set
+*   setUnion		- Returns a new set of the elements found in either of two sets
+*   setIntersect	- Returns a new set of the elements found in both of two sets
+*   setGetMemoryUsage - Returns the bytes used by the set and its elements
+* 	 SET_FOREACH	- A macro for iterating over the set's elements.
+*/
+
+/** Type for defining the set */
+typedef struct Set_t *Set;
+
+/** Type used for returning error codes from set functions */
+typedef enum SetResult_t {
+    SET_SUCCESS,
+    SET_OUT_OF_MEMORY,
+    SET_NULL_ARGUMENT,
+    SET_ITEM_ALREADY_EXISTS,
+    SET_ITEM_DOES_NOT_EXIST
+} SetResult;
+
+/** Element data type for set container */
+typedef void *SetElement;
+
+/** Type of function for copying an element of the set */
+typedef SetElement(*copySetElements)(SetElement);
+
+/** Type of function for deallocating an element of the set */
+typedef void(*freeSetElements)(SetElement);
+
+/**
+* Type of function used by the set to identify equal elements.
+* This function should return:
+* 		A positive integer if the first element is greater;
+* 		0 if they're equal;
+*		A negative integer if the second element is greater.
+*/
+typedef int(*compareSetElements)(SetElement, SetElement);
+
+/** Type of function returning the number of bytes an element uses, including memory it owns */
+typedef size_t(*sizeOfSetElements)(SetElement);
+
+/**
+* setCreate: Allocates a new empty set.
+*
+* @param copyElement - Function pointer to be used for copying elements into the set
+* 		or when copying the set.
+* @param freeElement - Function pointer to be used for removing elements from the set
+* @param compareElements - Function pointer to be used for comparing elements inside the set.
+* @return
+* 	NULL - if one of the parameters is NULL or allocations failed.
+* 	A new Set in case of success.
+*/
+Set setCreate(copySetElements copyElement, freeSetElements freeElement, compareSetElements compareElements);
+
+/**
+* setDestroy: Deallocates an existing set. Clears all elements by using the stored free function.
+*
+* @param set - Target set to be deallocated. If set is NULL nothing will be done
+*/
+void setDestroy(Set set);
+
+/**
+* setCopy: Creates a copy of target set.
+* Iterator values for both sets is undefined after this operation.
+*
+* @param set - Target set.
+* @return
+* 	NULL if a NULL was sent or a memory allocation failed.
+* 	A Set containing the same elements as set otherwise.
+*/
+Set setCopy(Set set);
+
+/**
+* setGetSize: Returns the number of elements in a set
+* @param set - The set which size is requested
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	Otherwise the number of elements in the set.
+*/
+int setGetSize(Set set);
+
+/**
+* setContains: Checks if an element exists in the set, in O(log n).
+*
+* @param set - The set to search in
+* @param element - The element to look for. Will be compared using the comparison function.
+* @return
+* 	false - if one or more of the inputs is null, or if the element was not found.
+* 	true - if the element was found in the set.
+*/
+bool setContains(Set set, SetElement element);
+
+/**
+* setAdd: Adds a copy of an element to the set, in O(log n).
+* Iterator's value is undefined after this operation.
+*
+* @param set - The set to add to
+* @param element - The element to add. A copy of it is inserted, as supplied by the
+* 		copying function given at initialization.
+* @return
+* 	SET_NULL_ARGUMENT if a NULL was sent as set or element
+* 	SET_ITEM_ALREADY_EXISTS if an equal element already exists in the set
+* 	SET_OUT_OF_MEMORY if an allocation failed
+* 	SET_SUCCESS the element had been added successfully
+*/
+SetResult setAdd(Set set, SetElement element);
+
+/**
+* setRemove: Removes an element from the set and frees it using the free function
+* given at initialization, in O(log n).
+* Iterator's value is undefined after this operation.
+*
+* @param set - The set to remove from
+* @param element - The element to find and remove
+* @return
+* 	SET_NULL_ARGUMENT if a NULL was sent to the function
+* 	SET_ITEM_DOES_NOT_EXIST if an equal element does not exist in the set
+* 	SET_SUCCESS the element had been removed successfully
+*/
+SetResult setRemove(Set set, SetElement element);
+
+/**
+* setGetFirst: Sets the internal iterator to the smallest element in the set and returns it.
+*
+* @param set - The set for which to set the iterator and return the first element.
+* @return
+* 	NULL if a NULL pointer was sent, the set is empty or a memory allocation failed.
+* 	A copy of the first element otherwise, to be freed by the caller.
+*/
+SetElement setGetFirst(Set set);
+
+/**
+* setGetNext: Advances the set iterator to the next element and returns it.
+*
+* @param set - The set for which to advance the iterator
+* @return
+* 	NULL if reached the end of the set, or the iterator is at an invalid state
+* 	or a NULL sent as argument
+* 	A copy of the next element otherwise, to be freed by the caller.
+*/
+SetElement setGetNext(Set set);
+
+/**
+* setGetByRank: Returns the element at a given position in the set's order, in O(log n).
+* Iterator status unchanged
+*
+* @param set - The set to search in
+* @param rank - The zero based position of the requested element, 0 being the smallest element
+* @return
+* 	NULL if a NULL pointer was sent, rank is out of range or a memory allocation failed.
+* 	A copy of the element at the given position otherwise, to be freed by the caller.
+*/
+SetElement setGetByRank(Set set, int rank);
+
+/**
+* setRankOf: Returns the number of elements in the set which are smaller than the given
+* element, in O(log n). The element does not need to be in the set. If it is, the result
+* is its position as accepted by setGetByRank.
+* Iterator status unchanged
+*
+* @param set - The set to search in
+* @param element - The element to rank
+* @return
+* 	-1 if a NULL pointer was sent.
+* 	The number of smaller elements otherwise.
+*/
+int setRankOf(Set set, SetElement element);
+
+/**
+* setClear: Removes all elements from target set, freeing them using the stored free function.
+* @param set - Target set to remove all element from.
+* @return
+* 	SET_NULL_ARGUMENT - if a NULL pointer was sent.
+* 	SET_SUCCESS - Otherwise.
+*/
+SetResult setClear(Set set);
+
+/**
+* setUnion: Creates a new set of all the elements found in at least one of two sets.
+* Both sets must use the same element functions, which the new set uses as well.
+* Iterator status of both sets unchanged
+*
+* @param first - The first set
+* @param second - The second set
+* @return
+* 	NULL if a NULL was sent or a memory allocation failed.
+* 	The union of the sets otherwise.
+*/
+Set setUnion(Set first, Set second);
+
+/**
+* setIntersect: Creates a new set of all the elements found in both of two sets,
+* in O(m log n) where m is the size of the smaller set.
+* Both sets must use the same element functions, which the new set uses as well.
+* Iterator status of both sets unchanged
+*
+* @param first - The first set
+* @param second - The second set
+* @return
+* 	NULL if a NULL was sent or a memory allocation failed.
+* 	The intersection of the sets otherwise.
+*/
+Set setIntersect(Set first, Set second);
+
+/**
+* setGetMemoryUsage: Returns the bytes held by a set, as mapGetMemoryUsage counts them.
+* Iterator status unchanged
+*
+* @param set - The set to measure
+* @param elementSize - Returns the bytes used by an element. If NULL, elements are not counted.
+* @return
+* 	0 if a NULL was sent as set.
+* 	The bytes of the set's structure and elements otherwise.
+*/
+size_t setGetMemoryUsage(Set set, sizeOfSetElements elementSize);
+
+/*!
+* Macro for iterating over a set.
+* Declares a new iterator for the loop.
+*/
+#define SET_FOREACH(type, iterator, set) \
+    for(type iterator = (type) setGetFirst(set) ; \
+        iterator ;\
+        iterator = setGetNext(set))
+
+#endif /* SET_H_ */
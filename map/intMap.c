@@ -0,0 +1,386 @@
+#define _POSIX_C_SOURCE 200809L
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include "headers/cpuFeatures.h"
+#include "headers/intMap.h"
+
+#ifdef HAS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+//Defines
+#define NULL_ARGUMENT_INDICATOR (-1)
+#define KEY_PADDING INT_MAX
+#define SPLIT_POINT (INT_MAP_ORDER / 2)
+#define CACHE_LINE_SIZE 64
+
+/**
+ * A node of the B+ tree. The keys beyond size are always KEY_PADDING, so a whole node can be compared
+ * against a key at once. Nodes start on a cache line, and the keys come first, so they fill exactly one line. In a leaf, slots[i] is the data element of keys[i] and next is the following leaf.
+ * In an inner node, slots[i] is the child holding the keys in [keys[i-1], keys[i]).
+ */
+typedef struct IntMapNode_t {
+    int keys[INT_MAP_ORDER];
+    void *slots[INT_MAP_ORDER + 1];
+    struct IntMapNode_t *next;
+    int size;
+    bool is_leaf;
+} *IntMapNode;
+
+struct IntMap_t {
+    copyMapDataElements copyDataFunction;
+    freeMapDataElements freeDataFunction;
+    IntMapNode root;
+    IntMapNode iterator_leaf;
+    int iterator_index;
+    int size;
+};
+
+/** Type of the kernels counting the keys of a node which are smaller than a given key */
+typedef int(*countKeysLessFunction)(const int *, int);
+
+static pthread_once_t search_kernel_once = PTHREAD_ONCE_INIT;
+static countKeysLessFunction countKeysLess = NULL;
+
+static int countKeysLessScalar(const int *keys, int key);
+static void selectSearchKernel();
+static IntMapNode createNode(bool is_leaf);
+static void destroySubtree(IntMap map, IntMapNode node);
+static int findChildIndex(IntMapNode node, int key);
+static IntMapNode findLeaf(IntMap map, int key);
+static bool splitChild(IntMapNode parent, int index);
+static bool moveToFilledLeaf(IntMap map, int *key);
+
+static int countKeysLessScalar(const int *keys, int key){
+    int count = 0;
+    for(int i = 0; i < INT_MAP_ORDER; i++){
+        count += keys[i] < key;
+    }
+    return count;
+}
+
+#ifdef HAS_X86_KERNELS
+__attribute__((target("sse2")))
+static int countKeysLessSse2(const int *keys, int key){
+    __m128i key_vector = _mm_set1_epi32(key);
+    int count = 0;
+    for(int i = 0; i < INT_MAP_ORDER; i += 4){
+        __m128i node_keys = _mm_loadu_si128((const __m128i *) (keys + i));
+        __m128i is_less = _mm_cmpgt_epi32(key_vector, node_keys);
+        count += __builtin_popcount((unsigned int) _mm_movemask_ps(_mm_castsi128_ps(is_less)));
+    }
+    return count;
+}
+
+__attribute__((target("avx2")))
+static int countKeysLessAvx2(const int *keys, int key){
+    __m256i key_vector = _mm256_set1_epi32(key);
+    int count = 0;
+    for(int i = 0; i < INT_MAP_ORDER; i += 8){
+        __m256i node_keys = _mm256_loadu_si256((const __m256i *) (keys + i));
+        __m256i is_less = _mm256_cmpgt_epi32(key_vector, node_keys);
+        count += __builtin_popcount((unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(is_less)));
+    }
+    return count;
+}
+#endif
+
+/**
+ * Picks the widest node search kernel the CPU supports
+ */
+static void selectSearchKernel(){
+    countKeysLess = countKeysLessScalar;
+#ifdef HAS_X86_KERNELS
+    switch(cpuGetVectorLevel()){
+        case CPU_VECTOR_AVX2:
+            countKeysLess = countKeysLessAvx2;
+            break;
+        case CPU_VECTOR_SSE2:
+            countKeysLess = countKeysLessSse2;
+            break;
+        default:
+            break;
+    }
+#endif
+}
+
+IntMap intMapCreate(copyMapDataElements copyDataElement, freeMapDataElements freeDataElement){
+    if(copyDataElement == NULL || freeDataElement == NULL){
+        return NULL;
+    }
+    pthread_once(&search_kernel_once, selectSearchKernel);
+    IntMap map = malloc(sizeof(*map));
+    if(map == NULL){
+        return NULL;
+    }
+    map->root = createNode(true);
+    if(map->root == NULL){
+        free(map);
+        return NULL;
+    }
+    map->copyDataFunction = copyDataElement;
+    map->freeDataFunction = freeDataElement;
+    map->iterator_leaf = NULL;
+    map->iterator_index = 0;
+    map->size = 0;
+    return map;
+}
+
+void intMapDestroy(IntMap map){
+    if(map == NULL){
+        return;
+    }
+    destroySubtree(map, map->root);
+    free(map);
+}
+
+int intMapGetSize(IntMap map){
+    if(map == NULL){
+        return NULL_ARGUMENT_INDICATOR;
+    }
+    return map->size;
+}
+
+bool intMapContains(IntMap map, int key){
+    return intMapGet(map, key) != NULL;
+}
+
+MapDataElement intMapGet(IntMap map, int key){
+    if(map == NULL){
+        return NULL;
+    }
+    IntMapNode leaf = findLeaf(map, key);
+    int index = countKeysLess(leaf->keys, key);
+    if(index < leaf->size && leaf->keys[index] == key){
+        return leaf->slots[index];
+    }
+    return NULL;
+}
+
+MapResult intMapPut(IntMap map, int key, MapDataElement dataElement){
+    if(map == NULL || dataElement == NULL){
+        return MAP_NULL_ARGUMENT;
+    }
+    MapDataElement new_data = map->copyDataFunction(dataElement);
+    if(new_data == NULL){
+        return MAP_OUT_OF_MEMORY;
+    }
+    if(map->root->size == INT_MAP_ORDER){
+        IntMapNode new_root = createNode(false);
+        if(new_root == NULL){
+            map->freeDataFunction(new_data);
+            return MAP_OUT_OF_MEMORY;
+        }
+        new_root->slots[0] = map->root;
+        if(!splitChild(new_root, 0)){
+            free(new_root);
+            map->freeDataFunction(new_data);
+            return MAP_OUT_OF_MEMORY;
+        }
+        map->root = new_root;
+    }
+    // Split full nodes on the way down, so there is always room for a separator in the parent
+    IntMapNode node = map->root;
+    while(!node->is_leaf){
+        int index = findChildIndex(node, key);
+        IntMapNode child = node->slots[index];
+        if(child->size == INT_MAP_ORDER){
+            if(!splitChild(node, index)){
+                map->freeDataFunction(new_data);
+                return MAP_OUT_OF_MEMORY;
+            }
+            if(key >= node->keys[index]){
+                index++;
+            }
+            child = node->slots[index];
+        }
+        node = child;
+    }
+    int index = countKeysLess(node->keys, key);
+    if(index < node->size && node->keys[index] == key){
+        map->freeDataFunction(node->slots[index]);
+        node->slots[index] = new_data;
+        return MAP_SUCCESS;
+    }
+    for(int i = node->size; i > index; i--){
+        node->keys[i] = node->keys[i - 1];
+        node->slots[i] = node->slots[i - 1];
+    }
+    node->keys[index] = key;
+    node->slots[index] = new_data;
+    node->size++;
+    map->size++;
+    return MAP_SUCCESS;
+}
+
+MapResult intMapRemove(IntMap map, int key){
+    if(map == NULL){
+        return MAP_NULL_ARGUMENT;
+    }
+    IntMapNode leaf = findLeaf(map, key);
+    int index = countKeysLess(leaf->keys, key);
+    if(index >= leaf->size || leaf->keys[index] != key){
+        return MAP_ITEM_DOES_NOT_EXIST;
+    }
+    map->freeDataFunction(leaf->slots[index]);
+    for(int i = index; i < leaf->size - 1; i++){
+        leaf->keys[i] = leaf->keys[i + 1];
+        leaf->slots[i] = leaf->slots[i + 1];
+    }
+    leaf->size--;
+    leaf->keys[leaf->size] = KEY_PADDING;
+    map->size--;
+    return MAP_SUCCESS;
+}
+
+bool intMapGetFirst(IntMap map, int *key){
+    if(map == NULL || key == NULL){
+        return false;
+    }
+    IntMapNode node = map->root;
+    while(!node->is_leaf){
+        node = node->slots[0];
+    }
+    map->iterator_leaf = node;
+    map->iterator_index = 0;
+    return moveToFilledLeaf(map, key);
+}
+
+bool intMapGetNext(IntMap map, int *key){
+    if(map == NULL || key == NULL || map->iterator_leaf == NULL){
+        return false;
+    }
+    map->iterator_index++;
+    return moveToFilledLeaf(map, key);
+}
+
+MapResult intMapClear(IntMap map){
+    if(map == NULL){
+        return MAP_NULL_ARGUMENT;
+    }
+    IntMapNode empty_root = createNode(true);
+    if(empty_root == NULL){
+        return MAP_OUT_OF_MEMORY;
+    }
+    destroySubtree(map, map->root);
+    map->root = empty_root;
+    map->iterator_leaf = NULL;
+    map->size = 0;
+    return MAP_SUCCESS;
+}
+
+/**
+ * Skips the iterator over exhausted and emptied leaves
+ * @param map
+ * @param key - The key at the iterator is stored here
+ * @return false if the iterator reached the end, true otherwise
+ */
+static bool moveToFilledLeaf(IntMap map, int *key){
+    while(map->iterator_leaf != NULL && map->iterator_index >= map->iterator_leaf->size){
+        map->iterator_leaf = map->iterator_leaf->next;
+        map->iterator_index = 0;
+    }
+    if(map->iterator_leaf == NULL){
+        return false;
+    }
+    *key = map->iterator_leaf->keys[map->iterator_index];
+    return true;
+}
+
+static IntMapNode createNode(bool is_leaf){
+    void *memory = NULL;
+    if(posix_memalign(&memory, CACHE_LINE_SIZE, sizeof(struct IntMapNode_t)) != 0){
+        return NULL;
+    }
+    IntMapNode node = memory;
+    for(int i = 0; i < INT_MAP_ORDER; i++){
+        node->keys[i] = KEY_PADDING;
+    }
+    node->next = NULL;
+    node->size = 0;
+    node->is_leaf = is_leaf;
+    return node;
+}
+
+static void destroySubtree(IntMap map, IntMapNode node){
+    if(node->is_leaf){
+        for(int i = 0; i < node->size; i++){
+            map->freeDataFunction(node->slots[i]);
+        }
+    } else {
+        for(int i = 0; i <= node->size; i++){
+            destroySubtree(map, node->slots[i]);
+        }
+    }
+    free(node);
+}
+
+/**
+ * Finds the child of an inner node which may hold a given key
+ * @param node - An inner node
+ * @param key
+ * @return The index of the child
+ */
+static int findChildIndex(IntMapNode node, int key){
+    int index = countKeysLess(node->keys, key);
+    if(index < node->size && node->keys[index] == key){
+        index++;
+    }
+    return index;
+}
+
+static IntMapNode findLeaf(IntMap map, int key){
+    IntMapNode node = map->root;
+    while(!node->is_leaf){
+        node = node->slots[findChildIndex(node, key)];
+    }
+    return node;
+}
+
+/**
+ * Splits a full child of a node in two, adding the separator and the new right half to the node.
+ * @param parent - A node which is not full
+ * @param index - The index of the full child in parent
+ * @return false if the allocation of the right half failed, in which case nothing is changed
+ */
+static bool splitChild(IntMapNode parent, int index){
+    IntMapNode child = parent->slots[index];
+    IntMapNode right = createNode(child->is_leaf);
+    if(right == NULL){
+        return false;
+    }
+    int separator;
+    if(child->is_leaf){
+        right->size = INT_MAP_ORDER - SPLIT_POINT;
+        for(int i = 0; i < right->size; i++){
+            right->keys[i] = child->keys[SPLIT_POINT + i];
+            right->slots[i] = child->slots[SPLIT_POINT + i];
+        }
+        right->next = child->next;
+        child->next = right;
+        separator = right->keys[0];
+    } else {
+        separator = child->keys[SPLIT_POINT];
+        right->size = INT_MAP_ORDER - SPLIT_POINT - 1;
+        for(int i = 0; i < right->size; i++){
+            right->keys[i] = child->keys[SPLIT_POINT + 1 + i];
+        }
+        for(int i = 0; i <= right->size; i++){
+            right->slots[i] = child->slots[SPLIT_POINT + 1 + i];
+        }
+    }
+    for(int i = SPLIT_POINT; i < INT_MAP_ORDER; i++){
+        child->keys[i] = KEY_PADDING;
+    }
+    child->size = SPLIT_POINT;
+
+    for(int i = parent->size; i > index; i--){
+        parent->keys[i] = parent->keys[i - 1];
+        parent->slots[i + 1] = parent->slots[i];
+    }
+    parent->keys[index] = separator;
+    parent->slots[index + 1] = right;
+    parent->size++;
+    return true;
+}
@@ -1,21 +1,86 @@
+#include <pthread.h>
+#include <string.h>
+#include "headers/hash.h"
 #include "headers/node.h"
 
 //Defines
 #define NULL_ARGUMENT_INDICATOR (-1)
+#define INITIAL_PRIORITY_SEED 0x9E3779B9u
+#define UNBOUNDED 0
+
+/**
+ * The key representation of maps created by mapCreateStringKeys. Stored keys are allocated in one block with
+ * their characters right after the header; the keys callers pass in are wrapped in a probe on the stack that
+ * points to the caller's characters.
+ */
+typedef struct HashedString_t {
+    unsigned int hash;
+    size_t length;
+    const char *chars;
+} HashedString;
 
-static MapResult reassignValue(Map map, MapKeyElement keyElement, MapDataElement dataElement);
-MapResult addNewValues(Map map, MapKeyElement keyElement, MapDataElement dataElement);
 static MapResult initializeNode(Map map, Node node, MapDataElement data, MapKeyElement key);
+static unsigned int generatePriority(Map map);
+static Node findNode(Map map, MapKeyElement keyElement);
+static Node mergeTrees(Node left, Node right);
+static void splitTree(Map map, Node tree, MapKeyElement keyElement, Node *less, Node *greater_or_equal);
+static Node removeFromTree(Map map, Node tree, MapKeyElement keyElement);
+static Node findPredecessor(Map map, MapKeyElement keyElement);
+static void insertNode(Map map, Node node);
+static Node copySubtree(Map map, Node tree, bool *failed);
+static void destroySubtree(Map map, Node tree);
+static void threadSubtree(Map map, Node tree, Node *previous);
+static void removeNode(Map map, Node node);
+static void evictEntry(Map map);
+static Node findNodeByRank(Map map, int rank);
+static void *scanChunk(void *chunk);
+static MapResult scanInParallel(Map map, applyOnMapElements apply, accumulateMapElements accumulate,
+                                void *context, size_t contextSize, int threads);
+static MapKeyElement copyHashedString(MapKeyElement key);
+static void freeHashedString(MapKeyElement key);
+static int compareHashedStrings(MapKeyElement first, MapKeyElement second);
+static MapKeyElement wrapKey(Map map, MapKeyElement keyElement, HashedString *probe);
+static MapKeyElement exposeKey(Map map, Node node);
+static MapKeyElement exportKey(Map map, Node node);
 
+/** A contiguous range of the map scanned by one worker thread */
+typedef struct MapChunk_t {
+    Map map;
+    Node first;
+    int length;
+    applyOnMapElements apply;
+    accumulateMapElements accumulate;
+    void *context;
+    pthread_t thread;
+    bool is_running;
+} MapChunk;
+
+/**
+ * The map is kept as a treap (a binary search tree ordered by key and heap-ordered by a random priority),
+ * so lookups, insertions and removals take O(log n) expected time. Every node also records the size of its
+ * subtree for rank queries, and the nodes are threaded in key order through their next pointer
+ * (starting at elements), which is what the internal iterator walks.
+ * A bounded map evicts entries with the CLOCK policy: the key order thread serves as the clock ring,
+ * clock_hand is the next eviction candidate, and every access only sets the node's referenced flag.
+ * The nodes are allocated in blocks from the map's own node pool.
+ * A map with string_keys stores HashedString keys, and translates keys from and to plain strings on the way
+ * in and out (wrapKey, exposeKey and exportKey).
+ */
 struct Map_t {
     copyMapDataElements copyDataFunction;
     copyMapKeyElements copyMapKeyFunction;
     freeMapDataElements freeMapDataFunction;
     freeMapKeyElements freeMapKeyFunction;
     compareMapKeyElements compareMapKeyFunction;
+    Node root;
     Node elements;
     Node iterator;
     int size;
+    unsigned int priority_seed;
+    int max_entries;
+    Node clock_hand;
+    NodePool nodes;
+    bool string_keys;
 };
 
 Map mapCreate(copyMapDataElements copyDataElement,
@@ -32,21 +97,59 @@ Map mapCreate(copyMapDataElements copyDataElement,
         free(map);
         return NULL;
     }
+    map->nodes = createNodePool();
+    if(map->nodes == NULL){
+        free(map);
+        return NULL;
+    }
     map->copyDataFunction = copyDataElement;
     map->copyMapKeyFunction = copyKeyElement;
     map->freeMapDataFunction = freeDataElement;
     map->freeMapKeyFunction = freeKeyElement;
     map->compareMapKeyFunction = compareKeyElements;
+    map->root = NULL;
     map->elements = NULL;
     map->iterator = NULL;
+    map->priority_seed = INITIAL_PRIORITY_SEED;
+    map->max_entries = UNBOUNDED;
+    map->clock_hand = NULL;
+    map->string_keys = false;
 
     map->size = 0;
     return map;
 }
 
+Map mapCreateStringKeys(copyMapDataElements copyDataElement, freeMapDataElements freeDataElement){
+    Map map = mapCreate(copyDataElement, copyHashedString, freeDataElement, freeHashedString,
+                        compareHashedStrings);
+    if(map == NULL){
+        return NULL;
+    }
+    map->string_keys = true;
+    return map;
+}
+
+Map mapCreateBounded(int maxEntries,
+                     copyMapDataElements copyDataElement,
+                     copyMapKeyElements copyKeyElement,
+                     freeMapDataElements freeDataElement,
+                     freeMapKeyElements freeKeyElement,
+                     compareMapKeyElements compareKeyElements){
+    if(maxEntries <= 0){
+        return NULL;
+    }
+    Map map = mapCreate(copyDataElement, copyKeyElement, freeDataElement, freeKeyElement, compareKeyElements);
+    if(map == NULL){
+        return NULL;
+    }
+    map->max_entries = maxEntries;
+    return map;
+}
+
 void mapDestroy(Map map){
     if(map == NULL) return;
     mapClear(map);
+    destroyNodePool(map->nodes);
     free(map);
 }
 
@@ -55,14 +158,14 @@ MapResult mapClear(Map map){
         return MAP_NULL_ARGUMENT;
     }
     map->iterator = NULL;
-    Node dummy = NULL;
     while(map->elements != NULL){
         map->freeMapKeyFunction(getKey(map->elements));
         map->freeMapDataFunction(getData((map->elements)));
-        dummy = map->elements;
-        map->elements = getNext(dummy);
-        free(dummy);
+        map->elements = getNext(map->elements);
     }
+    clearNodePool(map->nodes);
+    map->root = NULL;
+    map->clock_hand = NULL;
     map->size = 0;
     return MAP_SUCCESS;
 }
@@ -71,25 +174,52 @@ MapResult mapRemove(Map map, MapKeyElement keyElement){
     if(map == NULL || keyElement == NULL){
         return MAP_NULL_ARGUMENT;
     }
-    if(!mapContains(map, keyElement)){
+    HashedString probe;
+    Node node = findNode(map, wrapKey(map, keyElement, &probe));
+    if(node == NULL){
         return MAP_ITEM_DOES_NOT_EXIST;
     }
-    Node dummy = map->elements;
-    Node prev_node = NULL;
-    while(map->compareMapKeyFunction(getKey(dummy), keyElement) != 0){
-        prev_node = dummy;
-        dummy = getNext(dummy);
-    }
+    removeNode(map, node);
+    return MAP_SUCCESS;
+}
+
+/**
+ * Unlinks a node from the map and frees it along with its elements
+ * @param map
+ * @param node - A node of the map
+ */
+static void removeNode(Map map, Node node){
+    Node prev_node = findPredecessor(map, getKey(node));
     if(prev_node != NULL){
-        setNext(prev_node, getNext(dummy));
+        setNext(prev_node, getNext(node));
     } else {
-        map->elements = getNext(dummy);
+        map->elements = getNext(node);
+    }
+    if(map->clock_hand == node){
+        map->clock_hand = getNext(node);
     }
-    map->freeMapDataFunction(getData(dummy));
-    map->freeMapKeyFunction(getKey(dummy));
-    free(dummy);
+    map->root = removeFromTree(map, map->root, getKey(node));
+    map->freeMapDataFunction(getData(node));
+    map->freeMapKeyFunction(getKey(node));
+    releaseNode(map->nodes, node);
     map->size--;
-    return MAP_SUCCESS;
+}
+
+/**
+ * Removes the entry pointed by the clock hand, giving every referenced entry on the way a second chance
+ * @param map - A non empty map
+ */
+static void evictEntry(Map map){
+    Node candidate = map->clock_hand != NULL ? map->clock_hand : map->elements;
+    while(isReferenced(candidate)){
+        setReferenced(candidate, false);
+        candidate = getNext(candidate) != NULL ? getNext(candidate) : map->elements;
+        map->clock_hand = candidate;
+    }
+    // The hand resumes right after the evicted entry, past every entry this sweep already spared
+    Node successor = getNext(candidate);
+    removeNode(map, candidate);
+    map->clock_hand = successor != NULL ? successor : map->elements;
 }
 
 Map mapCopy(Map map){
@@ -103,40 +233,20 @@ Map mapCopy(Map map){
         mapDestroy(map_copy);
         return NULL;
     }
-
-    if(mapGetSize(map) == 0){
-        return map_copy;
-    }
+    map_copy->string_keys = map->string_keys;
+    map_copy->priority_seed = map->priority_seed;
+    map_copy->max_entries = map->max_entries;
     if(map->size == 0) {
         return map_copy;
     }
-    map_copy->elements = createEmptyNode();
-    if(map_copy->elements == NULL){
+    bool failed = false;
+    map_copy->root = copySubtree(map_copy, map->root, &failed);
+    if(failed){
         mapDestroy(map_copy);
         return NULL;
     }
-    if(map->size == 0){
-        return map_copy;
-    }
-    Node copy_dummy = map_copy->elements;
-    Node original_dummy = map->elements;
-    for(int i=1; i<map->size; i++){
-        setNext(copy_dummy, createEmptyNode());
-        if(getNext(copy_dummy) == NULL){
-            mapDestroy(map_copy);
-            return NULL;
-        }
-        copy_dummy = getNext(copy_dummy);
-    }
-    copy_dummy = map_copy->elements;
-    for(int i=0; i<map->size; i++){
-        if(initializeNode(map, copy_dummy, getData(original_dummy), getKey(original_dummy)) != MAP_SUCCESS){
-            mapDestroy(map_copy);
-            return NULL;
-        }
-        copy_dummy = getNext(copy_dummy);
-        original_dummy = getNext(original_dummy);
-    }
+    Node previous = NULL;
+    threadSubtree(map_copy, map_copy->root, &previous);
     map_copy->size = map->size;
 
     return map_copy;
@@ -153,76 +263,38 @@ bool mapContains(Map map, MapKeyElement element){
     if(map == NULL || map->size == 0 || element == NULL){
         return false;
     }
-    Node dummy = map->elements;
-    if(dummy == NULL) {
-        return false;
-    }
-
-    int compareResult = map->compareMapKeyFunction(getKey(dummy), element);
-    while(getNext(dummy) != NULL && compareResult < 0){
-        dummy = getNext(dummy);
-        compareResult = map->compareMapKeyFunction(getKey(dummy), element);
-    }
-    return compareResult == 0;
+    HashedString probe;
+    return findNode(map, wrapKey(map, element, &probe)) != NULL;
 }
 
 MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement){
     if(map == NULL || keyElement == NULL || dataElement == NULL){
         return MAP_NULL_ARGUMENT;
     }
-    if(map->elements == NULL){
-        return addNewValues(map, keyElement, dataElement);
-    }
-    if(reassignValue(map, keyElement, dataElement) == MAP_SUCCESS){
+    HashedString probe;
+    keyElement = wrapKey(map, keyElement, &probe);
+    Node node = findNode(map, keyElement);
+    if(node != NULL){
+        MapDataElement temp_data = map->copyDataFunction(dataElement);
+        if(temp_data == NULL){
+            return MAP_OUT_OF_MEMORY;
+        }
+        setData(node, map->freeMapDataFunction, temp_data);
+        setReferenced(node, true);
         return MAP_SUCCESS;
     }
-    return addNewValues(map, keyElement, dataElement);
-}
-
-/**
- * Add new key-data pair
- * @param map
- * @param keyElement
- * @param dataElement
- * @return
- */
-MapResult addNewValues(Map map, MapKeyElement keyElement, MapDataElement dataElement){
-    MapResult result;
-    if(map->elements == NULL){
-        map->elements = createEmptyNode();
-        result = initializeNode(map, map->elements, dataElement, keyElement);
-        if(result == MAP_SUCCESS){
-            map->size++;
-        } else {
-            free(map->elements);
-            map->elements = NULL;
+    node = allocateNode(map->nodes);
+    if(initializeNode(map, node, dataElement, keyElement) != MAP_SUCCESS){
+        if(node != NULL){
+            releaseNode(map->nodes, node);
         }
-        return result;
-    }
-    Node dummy = map->elements;
-    Node previous_node = dummy;
-    int compareResult = map->compareMapKeyFunction(keyElement, getKey(dummy));
-    Node newNode = createEmptyNode();
-    if(initializeNode(map, newNode, dataElement, keyElement) != MAP_SUCCESS){
         return MAP_OUT_OF_MEMORY;
     }
-    if(compareResult < 0){
-        setNext(newNode, dummy);
-        map->elements = newNode;
-    } else {
-        while(getNext(dummy) != NULL && compareResult > 0){
-            previous_node = dummy;
-            dummy = getNext(dummy);
-            compareResult = map->compareMapKeyFunction(keyElement, getKey(dummy));
-        }
-
-        if(compareResult > 0){
-            setNext(dummy, newNode);
-        } else {
-            setNext(newNode, dummy);
-            setNext(previous_node, newNode);
-        }
+    if(map->max_entries != UNBOUNDED && map->size >= map->max_entries){
+        evictEntry(map);
     }
+    insertNode(map, node);
+    setReferenced(node, true);
     map->size++;
     return MAP_SUCCESS;
 }
@@ -244,57 +316,243 @@ static MapResult initializeNode(Map map, Node node, MapDataElement data, MapKeyE
     }
     setKey(node, new_key);
     setData(node, map->freeMapDataFunction, new_data);
+    setPriority(node, generatePriority(map));
     return MAP_SUCCESS;
 }
 
 /**
- * If key exists, reassign data associated with it
- * @param map - The map to which we reassign the data
- * @param keyElement - The key which we need to reassign
- * @param dataElement - The new data
- * @return MAP_ITEM_DOES_NOT_EXIST if map doesn't contain key, MAP_SUCCESS if data was updated successfully
+ * Draws the next pseudo-random node priority (xorshift32)
+ * @param map - The map owning the generator state
+ * @return A new priority
  */
-static MapResult reassignValue(Map map, MapKeyElement keyElement, MapDataElement dataElement){
-    if(!mapContains(map, keyElement)){
-        return MAP_ITEM_DOES_NOT_EXIST;
+static unsigned int generatePriority(Map map){
+    unsigned int seed = map->priority_seed;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    map->priority_seed = seed;
+    return seed;
+}
+
+/**
+ * Finds the node holding a key equal to the given key
+ * @param map
+ * @param keyElement
+ * @return The node if found, NULL otherwise
+ */
+static Node findNode(Map map, MapKeyElement keyElement){
+    Node dummy = map->root;
+    while(dummy != NULL){
+        int compareResult = map->compareMapKeyFunction(getKey(dummy), keyElement);
+        if(compareResult == 0){
+            return dummy;
+        }
+        dummy = compareResult < 0 ? getRight(dummy) : getLeft(dummy);
     }
-    Node dummy = map->elements;
+    return NULL;
+}
 
-    while(getNext(dummy) != NULL && map->compareMapKeyFunction(getKey(dummy), keyElement)){
-        dummy = getNext(dummy);
+/**
+ * Finds the node holding the greatest key which is smaller than the given key
+ * @param map
+ * @param keyElement
+ * @return The node if found, NULL if no smaller key exists
+ */
+static Node findPredecessor(Map map, MapKeyElement keyElement){
+    Node dummy = map->root;
+    Node predecessor = NULL;
+    while(dummy != NULL){
+        if(map->compareMapKeyFunction(getKey(dummy), keyElement) < 0){
+            predecessor = dummy;
+            dummy = getRight(dummy);
+        } else {
+            dummy = getLeft(dummy);
+        }
     }
-    MapDataElement temp_data = map->copyDataFunction(dataElement);
-    if(temp_data == NULL){
-        map->freeMapDataFunction(temp_data);
-        return MAP_OUT_OF_MEMORY;
+    return predecessor;
+}
+
+/**
+ * Joins two treaps into one
+ * @param left - A treap whose keys are all smaller than the keys of right
+ * @param right
+ * @return The root of the joined treap
+ */
+static Node mergeTrees(Node left, Node right){
+    if(left == NULL){
+        return right;
     }
-    setData(dummy, map->freeMapDataFunction ,temp_data);
-    return MAP_SUCCESS;
+    if(right == NULL){
+        return left;
+    }
+    if(getPriority(left) > getPriority(right)){
+        setRight(left, mergeTrees(getRight(left), right));
+        updateSubtreeSize(left);
+        return left;
+    }
+    setLeft(right, mergeTrees(left, getLeft(right)));
+    updateSubtreeSize(right);
+    return right;
+}
+
+/**
+ * Splits a treap in two around a given key
+ * @param map
+ * @param tree - The treap to split
+ * @param keyElement - The key to split around
+ * @param less - Will hold the treap of all keys smaller than keyElement
+ * @param greater_or_equal - Will hold the treap of all remaining keys
+ */
+static void splitTree(Map map, Node tree, MapKeyElement keyElement, Node *less, Node *greater_or_equal){
+    if(tree == NULL){
+        *less = NULL;
+        *greater_or_equal = NULL;
+        return;
+    }
+    if(map->compareMapKeyFunction(getKey(tree), keyElement) < 0){
+        Node right_less = NULL;
+        splitTree(map, getRight(tree), keyElement, &right_less, greater_or_equal);
+        setRight(tree, right_less);
+        *less = tree;
+    } else {
+        Node left_greater = NULL;
+        splitTree(map, getLeft(tree), keyElement, less, &left_greater);
+        setLeft(tree, left_greater);
+        *greater_or_equal = tree;
+    }
+    updateSubtreeSize(tree);
+}
+
+/**
+ * Adds an initialized node, whose key is not in the map yet, to the tree and to the ordered thread
+ * @param map
+ * @param node
+ */
+static void insertNode(Map map, Node node){
+    Node less = NULL, greater = NULL;
+    splitTree(map, map->root, getKey(node), &less, &greater);
+
+    Node successor = greater;
+    while(successor != NULL && getLeft(successor) != NULL){
+        successor = getLeft(successor);
+    }
+    Node predecessor = less;
+    while(predecessor != NULL && getRight(predecessor) != NULL){
+        predecessor = getRight(predecessor);
+    }
+    setNext(node, successor);
+    if(predecessor != NULL){
+        setNext(predecessor, node);
+    } else {
+        map->elements = node;
+    }
+    map->root = mergeTrees(mergeTrees(less, node), greater);
+}
+
+/**
+ * Unlinks the node holding a given key from a treap. The node itself is not freed.
+ * @param map
+ * @param tree
+ * @param keyElement - A key which exists in the tree
+ * @return The new root of the treap
+ */
+static Node removeFromTree(Map map, Node tree, MapKeyElement keyElement){
+    int compareResult = map->compareMapKeyFunction(getKey(tree), keyElement);
+    if(compareResult == 0){
+        return mergeTrees(getLeft(tree), getRight(tree));
+    }
+    if(compareResult < 0){
+        setRight(tree, removeFromTree(map, getRight(tree), keyElement));
+    } else {
+        setLeft(tree, removeFromTree(map, getLeft(tree), keyElement));
+    }
+    updateSubtreeSize(tree);
+    return tree;
+}
+
+/**
+ * Deep copies a subtree, keeping its shape and priorities
+ * @param map - The map the copy belongs to, its copy functions and node pool are used
+ * @param tree
+ * @param failed - Set to true if an allocation failed, in which case nothing is left allocated
+ * @return The root of the copy
+ */
+static Node copySubtree(Map map, Node tree, bool *failed){
+    if(tree == NULL){
+        return NULL;
+    }
+    Node copy = allocateNode(map->nodes);
+    if(initializeNode(map, copy, getData(tree), getKey(tree)) != MAP_SUCCESS){
+        if(copy != NULL){
+            releaseNode(map->nodes, copy);
+        }
+        *failed = true;
+        return NULL;
+    }
+    setPriority(copy, getPriority(tree));
+    setLeft(copy, copySubtree(map, getLeft(tree), failed));
+    if(!*failed){
+        setRight(copy, copySubtree(map, getRight(tree), failed));
+    }
+    updateSubtreeSize(copy);
+    if(*failed){
+        destroySubtree(map, copy);
+        return NULL;
+    }
+    return copy;
+}
+
+static void destroySubtree(Map map, Node tree){
+    if(tree == NULL){
+        return;
+    }
+    destroySubtree(map, getLeft(tree));
+    destroySubtree(map, getRight(tree));
+    map->freeMapKeyFunction(getKey(tree));
+    map->freeMapDataFunction(getData(tree));
+    releaseNode(map->nodes, tree);
+}
+
+/**
+ * Links the nodes of a subtree in key order through their next pointers
+ * @param map
+ * @param tree
+ * @param previous - The last node linked so far, NULL if none
+ */
+static void threadSubtree(Map map, Node tree, Node *previous){
+    if(tree == NULL){
+        return;
+    }
+    threadSubtree(map, getLeft(tree), previous);
+    if(*previous != NULL){
+        setNext(*previous, tree);
+    } else {
+        map->elements = tree;
+    }
+    *previous = tree;
+    threadSubtree(map, getRight(tree), previous);
 }
 
 MapKeyElement mapGetFirst(Map map){
     if(map == NULL || map->size == 0)
         return NULL;
     map->iterator = map->elements;
-    MapKeyElement key = map->copyMapKeyFunction((MapKeyElement)getKey(map->iterator));
-    return key;
+    return exportKey(map, map->iterator);
 }
 
 MapDataElement mapGet(Map map, MapKeyElement keyElement){
-    if(map == NULL || map->size == 0 || !mapContains(map, keyElement)) {
+    if(map == NULL || map->size == 0 || keyElement == NULL) {
         return NULL;
     }
-
-    Node dummy = map->elements;
-    int compareResult = map->compareMapKeyFunction(keyElement, getKey(dummy));
-    while(getNext(dummy) != NULL && compareResult != 0){
-        dummy = getNext(dummy);
-        compareResult = map->compareMapKeyFunction(keyElement, getKey(dummy));
+    HashedString probe;
+    Node node = findNode(map, wrapKey(map, keyElement, &probe));
+    if(node == NULL) {
+        return NULL;
     }
-    if(compareResult == 0) {
-        return (MapDataElement) getData(dummy);
+    if(map->max_entries != UNBOUNDED){
+        setReferenced(node, true);
     }
-    return NULL;
+    return (MapDataElement) getData(node);
 }
 
 MapKeyElement mapGetNext(Map map){
@@ -306,6 +564,310 @@ MapKeyElement mapGetNext(Map map){
         return NULL;
     }
     map->iterator = next;
-    MapKeyElement key = getKey(map->iterator);
-    return map->copyMapKeyFunction(key);
+    return exportKey(map, map->iterator);
+}
+
+MapKeyElement mapGetByRank(Map map, int rank){
+    if(map == NULL || rank < 0 || rank >= map->size){
+        return NULL;
+    }
+    return exportKey(map, findNodeByRank(map, rank));
+}
+
+/**
+ * Finds the node at a given position in key order
+ * @param map
+ * @param rank - A position in the range [0, size)
+ * @return The node at the given position
+ */
+static Node findNodeByRank(Map map, int rank){
+    Node dummy = map->root;
+    while(dummy != NULL){
+        int left_size = getSubtreeSize(getLeft(dummy));
+        if(rank == left_size){
+            return dummy;
+        }
+        if(rank < left_size){
+            dummy = getLeft(dummy);
+        } else {
+            rank -= left_size + 1;
+            dummy = getRight(dummy);
+        }
+    }
+    return NULL;
+}
+
+int mapRankOf(Map map, MapKeyElement keyElement){
+    if(map == NULL || keyElement == NULL){
+        return NULL_ARGUMENT_INDICATOR;
+    }
+    HashedString probe;
+    keyElement = wrapKey(map, keyElement, &probe);
+    int rank = 0;
+    Node dummy = map->root;
+    while(dummy != NULL){
+        if(map->compareMapKeyFunction(getKey(dummy), keyElement) < 0){
+            rank += getSubtreeSize(getLeft(dummy)) + 1;
+            dummy = getRight(dummy);
+        } else {
+            dummy = getLeft(dummy);
+        }
+    }
+    return rank;
+}
+
+MapResult mapParallelForEach(Map map, applyOnMapElements apply, void *context, int threads){
+    if(map == NULL || apply == NULL){
+        return MAP_NULL_ARGUMENT;
+    }
+    return scanInParallel(map, apply, NULL, context, 0, threads);
+}
+
+MapResult mapParallelReduce(Map map, accumulateMapElements accumulate, combineMapAccumulators combine,
+                            void *accumulators, size_t accumulatorSize, int threads){
+    if(map == NULL || accumulate == NULL || accumulators == NULL){
+        return MAP_NULL_ARGUMENT;
+    }
+    MapResult result = scanInParallel(map, NULL, accumulate, accumulators, accumulatorSize, threads);
+    if(result != MAP_SUCCESS || combine == NULL){
+        return result;
+    }
+    char *accumulator = accumulators;
+    for(int i = 1; i < threads; i++){
+        combine(accumulator, accumulator + accumulatorSize * (size_t) i);
+    }
+    return MAP_SUCCESS;
+}
+
+/**
+ * Splits the map into contiguous chunks in key order and scans each one on its own thread.
+ * The first chunk is scanned by the calling thread. If a thread can not be started, its chunk
+ * is scanned by the calling thread as well.
+ * @param map
+ * @param apply - If not NULL, called with context for every element
+ * @param accumulate - If not NULL, called for every element with the accumulator of its chunk
+ * @param context - Passed to apply, or an array of one accumulator per thread for accumulate
+ * @param contextSize - The size of an accumulator
+ * @param threads - The number of chunks, at most one per element
+ * @return MAP_OUT_OF_MEMORY if the chunks could not be allocated, MAP_SUCCESS otherwise
+ */
+static MapResult scanInParallel(Map map, applyOnMapElements apply, accumulateMapElements accumulate,
+                                void *context, size_t contextSize, int threads){
+    int chunks_number = threads < map->size ? threads : map->size;
+    if(chunks_number <= 1){
+        MapChunk chunk;
+        chunk.map = map;
+        chunk.first = map->elements;
+        chunk.length = map->size;
+        chunk.apply = apply;
+        chunk.accumulate = accumulate;
+        chunk.context = context;
+        scanChunk(&chunk);
+        return MAP_SUCCESS;
+    }
+    MapChunk *chunks = malloc(sizeof(*chunks) * (size_t) chunks_number);
+    if(chunks == NULL){
+        return MAP_OUT_OF_MEMORY;
+    }
+    for(int i = 0; i < chunks_number; i++){
+        int first_rank = (int) ((long) map->size * i / chunks_number);
+        int end_rank = (int) ((long) map->size * (i + 1) / chunks_number);
+        chunks[i].map = map;
+        chunks[i].first = findNodeByRank(map, first_rank);
+        chunks[i].length = end_rank - first_rank;
+        chunks[i].apply = apply;
+        chunks[i].accumulate = accumulate;
+        chunks[i].context = accumulate == NULL ? context : (char *) context + contextSize * (size_t) i;
+        chunks[i].is_running = i > 0 && pthread_create(&chunks[i].thread, NULL, scanChunk, &chunks[i]) == 0;
+    }
+    for(int i = 0; i < chunks_number; i++){
+        if(chunks[i].is_running){
+            pthread_join(chunks[i].thread, NULL);
+        } else {
+            scanChunk(&chunks[i]);
+        }
+    }
+    free(chunks);
+    return MAP_SUCCESS;
+}
+
+static void *scanChunk(void *chunk){
+    MapChunk *range = chunk;
+    Node dummy = range->first;
+    for(int i = 0; i < range->length; i++){
+        if(range->apply != NULL){
+            range->apply(exposeKey(range->map, dummy), getData(dummy), range->context);
+        } else {
+            range->accumulate(range->context, exposeKey(range->map, dummy), getData(dummy));
+        }
+        dummy = getNext(dummy);
+    }
+    return NULL;
+}
+
+MapResult mapDiff(Map before, Map after, applyOnMapElements onAdded, applyOnMapElements onRemoved,
+                  applyOnChangedMapElements onChanged, equalMapDataElements dataEquals, void *context){
+    if(before == NULL || after == NULL || (onChanged != NULL && dataEquals == NULL)){
+        return MAP_NULL_ARGUMENT;
+    }
+    if(before == after){
+        return MAP_SUCCESS;
+    }
+    Node before_node = before->elements;
+    Node after_node = after->elements;
+    while(before_node != NULL || after_node != NULL){
+        int compareResult;
+        if(before_node == NULL){
+            compareResult = 1;
+        } else if(after_node == NULL){
+            compareResult = -1;
+        } else {
+            compareResult = before->compareMapKeyFunction(getKey(before_node), getKey(after_node));
+        }
+        if(compareResult < 0){
+            if(onRemoved != NULL){
+                onRemoved(exposeKey(before, before_node), getData(before_node), context);
+            }
+            before_node = getNext(before_node);
+        } else if(compareResult > 0){
+            if(onAdded != NULL){
+                onAdded(exposeKey(after, after_node), getData(after_node), context);
+            }
+            after_node = getNext(after_node);
+        } else {
+            if(onChanged != NULL && !dataEquals(getData(before_node), getData(after_node))){
+                onChanged(exposeKey(after, after_node), getData(before_node), getData(after_node), context);
+            }
+            before_node = getNext(before_node);
+            after_node = getNext(after_node);
+        }
+    }
+    return MAP_SUCCESS;
+}
+
+MapResult mapCompact(Map map){
+    if(map == NULL){
+        return MAP_NULL_ARGUMENT;
+    }
+    if(map->size == 0){
+        clearNodePool(map->nodes);
+        return MAP_SUCCESS;
+    }
+    NodePool compact_nodes = createNodePool();
+    if(compact_nodes == NULL || !reserveNodes(compact_nodes, map->size)){
+        destroyNodePool(compact_nodes);
+        return MAP_OUT_OF_MEMORY;
+    }
+    // The reserved block is handed out in order, so relocating along the key order thread lays it out sorted
+    for(Node dummy = map->elements; dummy != NULL; dummy = getNext(dummy)){
+        relocateNode(compact_nodes, dummy);
+    }
+    map->root = getRelocatedNode(map->root);
+    map->elements = getRelocatedNode(map->elements);
+    map->iterator = getRelocatedNode(map->iterator);
+    map->clock_hand = getRelocatedNode(map->clock_hand);
+    for(Node dummy = map->elements; dummy != NULL; dummy = getNext(dummy)){
+        resolveRelocatedLinks(dummy);
+    }
+    destroyNodePool(map->nodes);
+    map->nodes = compact_nodes;
+    return MAP_SUCCESS;
+}
+
+MapResult mapGetMemoryUsage(Map map, sizeOfMapKeyElements keySize, sizeOfMapDataElements dataSize,
+                            MapMemoryUsage *usage){
+    if(map == NULL || usage == NULL){
+        return MAP_NULL_ARGUMENT;
+    }
+    usage->structure = sizeof(*map) + getNodePoolMemory(map->nodes);
+    usage->keys = 0;
+    usage->values = 0;
+    for(Node dummy = map->elements; dummy != NULL; dummy = getNext(dummy)){
+        if(map->string_keys){
+            usage->keys += sizeof(HashedString) + ((HashedString *) getKey(dummy))->length + 1;
+        } else if(keySize != NULL){
+            usage->keys += keySize(getKey(dummy));
+        }
+        if(dataSize != NULL){
+            usage->values += dataSize(getData(dummy));
+        }
+    }
+    return MAP_SUCCESS;
+}
+
+static MapKeyElement copyHashedString(MapKeyElement key){
+    HashedString *original = key;
+    HashedString *copy = malloc(sizeof(*copy) + original->length + 1);
+    if(copy == NULL){
+        return NULL;
+    }
+    char *chars = (char *) (copy + 1);
+    memcpy(chars, original->chars, original->length + 1);
+    copy->hash = original->hash;
+    copy->length = original->length;
+    copy->chars = chars;
+    return copy;
+}
+
+static void freeHashedString(MapKeyElement key){
+    free(key);
+}
+
+/**
+ * Orders hashed strings by hash, then by length, so the characters are only compared for equal keys
+ * and hash collisions
+ */
+static int compareHashedStrings(MapKeyElement first, MapKeyElement second){
+    HashedString *first_string = first;
+    HashedString *second_string = second;
+    if(first_string->hash != second_string->hash){
+        return first_string->hash < second_string->hash ? -1 : 1;
+    }
+    if(first_string->length != second_string->length){
+        return first_string->length < second_string->length ? -1 : 1;
+    }
+    return memcmp(first_string->chars, second_string->chars, first_string->length);
+}
+
+/**
+ * Translates a key passed by the caller into the map's key representation
+ * @param map
+ * @param keyElement - A key as passed to the map's functions
+ * @param probe - Storage for the translated key, valid as long as keyElement is
+ * @return The key to search the tree with
+ */
+static MapKeyElement wrapKey(Map map, MapKeyElement keyElement, HashedString *probe){
+    if(!map->string_keys){
+        return keyElement;
+    }
+    probe->chars = keyElement;
+    probe->length = strlen(probe->chars);
+    probe->hash = hashFnv1a(FNV_OFFSET_BASIS, probe->chars, probe->length);
+    return probe;
+}
+
+/**
+ * Returns the key of a node as passed to callbacks, without copying it
+ */
+static MapKeyElement exposeKey(Map map, Node node){
+    if(!map->string_keys){
+        return getKey(node);
+    }
+    return (MapKeyElement) ((HashedString *) getKey(node))->chars;
+}
+
+/**
+ * Returns a copy of the key of a node, to be freed by the caller
+ */
+static MapKeyElement exportKey(Map map, Node node){
+    if(!map->string_keys){
+        return map->copyMapKeyFunction(getKey(node));
+    }
+    HashedString *key = getKey(node);
+    char *copy = malloc(key->length + 1);
+    if(copy == NULL){
+        return NULL;
+    }
+    memcpy(copy, key->chars, key->length + 1);
+    return copy;
 }
@@ -0,0 +1,310 @@
+#include <stdlib.h>
+#include "headers/map.h"
+#include "headers/multiMap.h"
+
+//Defines
+#define NULL_ARGUMENT_INDICATOR (-1)
+#define INITIAL_VALUES_CAPACITY 4
+#define EXPAND_FACTOR 2
+
+/**
+ * Values of a single key. Every list points back to the multi map owning it, so the Map data
+ * functions below can reach the value functions.
+ */
+typedef struct ValueList_t {
+    MultiMapValueElement *values;
+    int size;
+    int capacity;
+    MultiMap owner;
+} *ValueList;
+
+struct MultiMap_t {
+    Map lists;
+    struct ValueList_t empty_list;
+    copyMultiMapValueElements copyValueFunction;
+    freeMultiMapValueElements freeValueFunction;
+    equalMultiMapValueElements equalValueFunction;
+};
+
+static ValueList createValueList(MultiMap owner);
+static MapDataElement copyValueList(MapDataElement list);
+static void freeValueList(MapDataElement list);
+static ValueList getOrAddValueList(MultiMap multiMap, MultiMapKeyElement keyElement);
+static void addValueListMemory(MapKeyElement key, MapDataElement list, void *memoryUsage);
+
+/** The bytes summed by multiMapGetMemoryUsage over the value lists */
+typedef struct ValueListsMemory_t {
+    sizeOfMultiMapValueElements valueSize;
+    size_t bytes;
+} ValueListsMemory;
+
+MultiMap multiMapCreate(copyMultiMapKeyElements copyKeyElement,
+                        freeMultiMapKeyElements freeKeyElement,
+                        compareMultiMapKeyElements compareKeyElements,
+                        copyMultiMapValueElements copyValueElement,
+                        freeMultiMapValueElements freeValueElement,
+                        equalMultiMapValueElements equalValueElements){
+    if(copyKeyElement == NULL || freeKeyElement == NULL || compareKeyElements == NULL
+       || copyValueElement == NULL || freeValueElement == NULL || equalValueElements == NULL){
+        return NULL;
+    }
+    MultiMap multiMap = malloc(sizeof(*multiMap));
+    if(multiMap == NULL){
+        return NULL;
+    }
+    multiMap->lists = mapCreate(copyValueList, copyKeyElement, freeValueList, freeKeyElement, compareKeyElements);
+    if(multiMap->lists == NULL){
+        free(multiMap);
+        return NULL;
+    }
+    multiMap->copyValueFunction = copyValueElement;
+    multiMap->freeValueFunction = freeValueElement;
+    multiMap->equalValueFunction = equalValueElements;
+    multiMap->empty_list = (struct ValueList_t) {NULL, 0, 0, multiMap};
+    return multiMap;
+}
+
+void multiMapDestroy(MultiMap multiMap){
+    if(multiMap == NULL){
+        return;
+    }
+    mapDestroy(multiMap->lists);
+    free(multiMap);
+}
+
+int multiMapGetSize(MultiMap multiMap){
+    if(multiMap == NULL){
+        return NULL_ARGUMENT_INDICATOR;
+    }
+    return mapGetSize(multiMap->lists);
+}
+
+bool multiMapContains(MultiMap multiMap, MultiMapKeyElement keyElement){
+    if(multiMap == NULL){
+        return false;
+    }
+    return mapContains(multiMap->lists, keyElement);
+}
+
+MultiMapResult multiMapAppend(MultiMap multiMap, MultiMapKeyElement keyElement, MultiMapValueElement valueElement){
+    if(multiMap == NULL || keyElement == NULL || valueElement == NULL){
+        return MULTIMAP_NULL_ARGUMENT;
+    }
+    ValueList list = getOrAddValueList(multiMap, keyElement);
+    if(list == NULL){
+        return MULTIMAP_OUT_OF_MEMORY;
+    }
+    if(list->size == list->capacity){
+        int new_capacity = list->capacity * EXPAND_FACTOR;
+        MultiMapValueElement *values = realloc(list->values, sizeof(*values) * (size_t) new_capacity);
+        if(values == NULL){
+            return MULTIMAP_OUT_OF_MEMORY;
+        }
+        list->values = values;
+        list->capacity = new_capacity;
+    }
+    MultiMapValueElement new_value = multiMap->copyValueFunction(valueElement);
+    if(new_value == NULL){
+        if(list->size == 0){
+            mapRemove(multiMap->lists, keyElement);
+        }
+        return MULTIMAP_OUT_OF_MEMORY;
+    }
+    list->values[list->size++] = new_value;
+    return MULTIMAP_SUCCESS;
+}
+
+MultiMapValueElement *multiMapGetValues(MultiMap multiMap, MultiMapKeyElement keyElement, int *valuesCount){
+    if(valuesCount == NULL){
+        return NULL;
+    }
+    *valuesCount = 0;
+    if(multiMap == NULL){
+        return NULL;
+    }
+    ValueList list = mapGet(multiMap->lists, keyElement);
+    if(list == NULL){
+        return NULL;
+    }
+    *valuesCount = list->size;
+    return list->values;
+}
+
+MultiMapResult multiMapRemoveValueAt(MultiMap multiMap, MultiMapKeyElement keyElement, int index){
+    if(multiMap == NULL || keyElement == NULL){
+        return MULTIMAP_NULL_ARGUMENT;
+    }
+    ValueList list = mapGet(multiMap->lists, keyElement);
+    if(list == NULL || index < 0 || index >= list->size){
+        return MULTIMAP_ITEM_DOES_NOT_EXIST;
+    }
+    multiMap->freeValueFunction(list->values[index]);
+    list->values[index] = list->values[--list->size];
+    if(list->size == 0){
+        mapRemove(multiMap->lists, keyElement);
+    }
+    return MULTIMAP_SUCCESS;
+}
+
+MultiMapResult multiMapRemoveLastValue(MultiMap multiMap, MultiMapKeyElement keyElement){
+    if(multiMap == NULL || keyElement == NULL){
+        return MULTIMAP_NULL_ARGUMENT;
+    }
+    ValueList list = mapGet(multiMap->lists, keyElement);
+    if(list == NULL){
+        return MULTIMAP_ITEM_DOES_NOT_EXIST;
+    }
+    return multiMapRemoveValueAt(multiMap, keyElement, list->size - 1);
+}
+
+MultiMapResult multiMapRemoveValue(MultiMap multiMap, MultiMapKeyElement keyElement,
+                                   MultiMapValueElement valueElement){
+    if(multiMap == NULL || keyElement == NULL || valueElement == NULL){
+        return MULTIMAP_NULL_ARGUMENT;
+    }
+    ValueList list = mapGet(multiMap->lists, keyElement);
+    if(list == NULL){
+        return MULTIMAP_ITEM_DOES_NOT_EXIST;
+    }
+    for(int i = 0; i < list->size; i++){
+        if(multiMap->equalValueFunction(list->values[i], valueElement)){
+            return multiMapRemoveValueAt(multiMap, keyElement, i);
+        }
+    }
+    return MULTIMAP_ITEM_DOES_NOT_EXIST;
+}
+
+MultiMapResult multiMapRemoveKey(MultiMap multiMap, MultiMapKeyElement keyElement){
+    if(multiMap == NULL || keyElement == NULL){
+        return MULTIMAP_NULL_ARGUMENT;
+    }
+    if(mapRemove(multiMap->lists, keyElement) != MAP_SUCCESS){
+        return MULTIMAP_ITEM_DOES_NOT_EXIST;
+    }
+    return MULTIMAP_SUCCESS;
+}
+
+MultiMapKeyElement multiMapGetFirst(MultiMap multiMap){
+    if(multiMap == NULL){
+        return NULL;
+    }
+    return mapGetFirst(multiMap->lists);
+}
+
+MultiMapKeyElement multiMapGetNext(MultiMap multiMap){
+    if(multiMap == NULL){
+        return NULL;
+    }
+    return mapGetNext(multiMap->lists);
+}
+
+MultiMapResult multiMapClear(MultiMap multiMap){
+    if(multiMap == NULL){
+        return MULTIMAP_NULL_ARGUMENT;
+    }
+    mapClear(multiMap->lists);
+    return MULTIMAP_SUCCESS;
+}
+
+size_t multiMapGetMemoryUsage(MultiMap multiMap, sizeOfMultiMapKeyElements keySize,
+                              sizeOfMultiMapValueElements valueSize){
+    MapMemoryUsage usage;
+    if(multiMap == NULL || mapGetMemoryUsage(multiMap->lists, keySize, NULL, &usage) != MAP_SUCCESS){
+        return 0;
+    }
+    // The lists are walked in place on the calling thread, which neither copies keys nor moves the iterator
+    ValueListsMemory lists = {valueSize, 0};
+    mapParallelForEach(multiMap->lists, addValueListMemory, &lists, 1);
+    return sizeof(*multiMap) + usage.structure + usage.keys + lists.bytes;
+}
+
+/**
+ * Returns the value list of a key, adding an empty one if the key has no values
+ * @param multiMap
+ * @param keyElement
+ * @return The list of the key, NULL if an allocation failed
+ */
+static ValueList getOrAddValueList(MultiMap multiMap, MultiMapKeyElement keyElement){
+    ValueList list = mapGet(multiMap->lists, keyElement);
+    if(list != NULL){
+        return list;
+    }
+    // The map stores a copy of the shared empty list, which is the only list allocated here
+    if(mapPut(multiMap->lists, keyElement, &multiMap->empty_list) != MAP_SUCCESS){
+        return NULL;
+    }
+    return mapGet(multiMap->lists, keyElement);
+}
+
+static ValueList createValueList(MultiMap owner){
+    ValueList list = malloc(sizeof(*list));
+    if(list == NULL){
+        return NULL;
+    }
+    list->values = malloc(sizeof(*list->values) * INITIAL_VALUES_CAPACITY);
+    if(list->values == NULL){
+        free(list);
+        return NULL;
+    }
+    list->size = 0;
+    list->capacity = INITIAL_VALUES_CAPACITY;
+    list->owner = owner;
+    return list;
+}
+
+static MapDataElement copyValueList(MapDataElement list){
+    ValueList original = list;
+    ValueList copy = createValueList(original->owner);
+    if(copy == NULL){
+        return NULL;
+    }
+    for(int i = 0; i < original->size; i++){
+        if(copy->size == copy->capacity){
+            MultiMapValueElement *values = realloc(copy->values, sizeof(*values) * (size_t) original->capacity);
+            if(values == NULL){
+                freeValueList(copy);
+                return NULL;
+            }
+            copy->values = values;
+            copy->capacity = original->capacity;
+        }
+        copy->values[i] = original->owner->copyValueFunction(original->values[i]);
+        if(copy->values[i] == NULL){
+            freeValueList(copy);
+            return NULL;
+        }
+        copy->size++;
+    }
+    return copy;
+}
+
+static void freeValueList(MapDataElement list){
+    ValueList value_list = list;
+    if(value_list == NULL){
+        return;
+    }
+    for(int i = 0; i < value_list->size; i++){
+        value_list->owner->freeValueFunction(value_list->values[i]);
+    }
+    free(value_list->values);
+    free(value_list);
+}
+
+/**
+ * Adds the bytes of a value list, its array by capacity and its values, to a ValueListsMemory
+ * @param key
+ * @param list
+ * @param memoryUsage
+ */
+static void addValueListMemory(MapKeyElement key, MapDataElement list, void *memoryUsage){
+    (void) key;
+    ValueList value_list = list;
+    ValueListsMemory *lists = memoryUsage;
+    lists->bytes += sizeof(*value_list) + sizeof(*value_list->values) * (size_t) value_list->capacity;
+    if(lists->valueSize == NULL){
+        return;
+    }
+    for(int i = 0; i < value_list->size; i++){
+        lists->bytes += lists->valueSize(value_list->values[i]);
+    }
+}
@@ -4,19 +4,135 @@ struct node_t{
     MapDataElement data;
     MapKeyElement key;
     struct node_t *next;
+    struct node_t *left;
+    struct node_t *right;
+    unsigned int priority;
+    int subtree_size;
+    bool referenced;
 };
 
-Node createEmptyNode(){
-    Node node = malloc(sizeof(*node));
-    if(node == NULL){
+/**
+ * Nodes are carved out of blocks, normally of NODES_PER_BLOCK, so nodes allocated together share cache lines and
+ * walking the key order thread of a map touches a few blocks rather than scattered heap chunks.
+ * Released nodes are kept on a free list, linked through their next pointers, and reused first.
+ */
+typedef struct node_block_t {
+    struct node_block_t *next_block;
+    struct node_t nodes[];
+} *NodeBlock;
+
+struct node_pool_t {
+    NodeBlock blocks;
+    Node free_nodes;
+    size_t allocated_bytes;
+};
+
+static bool addBlock(NodePool pool, int count);
+
+NodePool createNodePool(){
+    NodePool pool = malloc(sizeof(*pool));
+    if(pool == NULL){
         return NULL;
     }
+    pool->blocks = NULL;
+    pool->free_nodes = NULL;
+    pool->allocated_bytes = 0;
+    return pool;
+}
+
+void destroyNodePool(NodePool pool){
+    if(pool == NULL){
+        return;
+    }
+    clearNodePool(pool);
+    free(pool);
+}
+
+void clearNodePool(NodePool pool){
+    while(pool->blocks != NULL){
+        NodeBlock block = pool->blocks;
+        pool->blocks = block->next_block;
+        free(block);
+    }
+    pool->free_nodes = NULL;
+    pool->allocated_bytes = 0;
+}
+
+size_t getNodePoolMemory(NodePool pool){
+    return sizeof(*pool) + pool->allocated_bytes;
+}
+
+bool reserveNodes(NodePool pool, int count){
+    return addBlock(pool, count);
+}
+
+/**
+ * Allocates a block of nodes and puts them on the free list, to be handed out in address order
+ * @param pool
+ * @param count - The number of nodes in the block
+ * @return false if the allocation failed
+ */
+static bool addBlock(NodePool pool, int count){
+    size_t block_size = sizeof(struct node_block_t) + sizeof(struct node_t) * (size_t) count;
+    NodeBlock block = malloc(block_size);
+    if(block == NULL){
+        return false;
+    }
+    pool->allocated_bytes += block_size;
+    block->next_block = pool->blocks;
+    pool->blocks = block;
+    for(int i = count - 1; i >= 0; i--){
+        block->nodes[i].next = pool->free_nodes;
+        pool->free_nodes = &block->nodes[i];
+    }
+    return true;
+}
+
+Node allocateNode(NodePool pool){
+    if(pool->free_nodes == NULL && !addBlock(pool, NODES_PER_BLOCK)){
+        return NULL;
+    }
+    Node node = pool->free_nodes;
+    pool->free_nodes = node->next;
     node->next = NULL;
     node->data = NULL;
     node->key = NULL;
+    node->left = NULL;
+    node->right = NULL;
+    node->priority = 0;
+    node->subtree_size = 1;
+    node->referenced = false;
     return node;
 }
 
+void releaseNode(NodePool pool, Node node){
+    node->next = pool->free_nodes;
+    pool->free_nodes = node;
+}
+
+// The copy keeps the links of the original, which is overwritten with a forwarding address in its left link
+Node relocateNode(NodePool pool, Node node){
+    Node copy = allocateNode(pool);
+    *copy = *node;
+    node->left = copy;
+    return copy;
+}
+
+// An original node's left link is its forwarding address once relocated
+static Node forwardedNode(Node node){
+    return node == NULL ? NULL : node->left;
+}
+
+void resolveRelocatedLinks(Node node){
+    node->left = forwardedNode(node->left);
+    node->right = forwardedNode(node->right);
+    node->next = forwardedNode(node->next);
+}
+
+Node getRelocatedNode(Node node){
+    return forwardedNode(node);
+}
+
 MapKeyElement getKey(Node node){
     return node->key;
 }
@@ -42,3 +158,46 @@ void setNext(Node setTo, Node nextNode){
     setTo->next = nextNode;
 }
 
+Node getLeft(Node node){
+    return node->left;
+}
+
+void setLeft(Node setTo, Node leftNode){
+    setTo->left = leftNode;
+}
+
+Node getRight(Node node){
+    return node->right;
+}
+
+void setRight(Node setTo, Node rightNode){
+    setTo->right = rightNode;
+}
+
+unsigned int getPriority(Node node){
+    return node->priority;
+}
+
+void setPriority(Node node, unsigned int priority){
+    node->priority = priority;
+}
+
+// An empty subtree (NULL) has size 0
+int getSubtreeSize(Node node){
+    if(node == NULL){
+        return 0;
+    }
+    return node->subtree_size;
+}
+
+void updateSubtreeSize(Node node){
+    node->subtree_size = 1 + getSubtreeSize(node->left) + getSubtreeSize(node->right);
+}
+
+bool isReferenced(Node node){
+    return node->referenced;
+}
+
+void setReferenced(Node node, bool referenced){
+    node->referenced = referenced;
+}
@@ -0,0 +1,289 @@
+#include <stdlib.h>
+#include "headers/priorityQueue.h"
+
+//Defines
+#define NULL_ARGUMENT_INDICATOR (-1)
+#define INITIAL_CAPACITY 16
+#define EXPAND_FACTOR 2
+#define FREE_HANDLE (-1)
+
+typedef struct HeapEntry_t {
+    PQElement element;
+    PQHandle handle;
+} HeapEntry;
+
+/**
+ * The queue is a binary max-heap stored in an array. positions maps every handle to the index of its
+ * element in the heap (FREE_HANDLE for unused handles), and free_handles is a stack of unused handles.
+ */
+struct PriorityQueue_t {
+    copyPQElements copyElementFunction;
+    freePQElements freeElementFunction;
+    comparePQElementPriorities comparePrioritiesFunction;
+    HeapEntry *heap;
+    int size;
+    int capacity;
+    int *positions;
+    int handles_count;
+    PQHandle *free_handles;
+    int free_handles_count;
+};
+
+static PriorityQueueResult expandQueue(PriorityQueue queue);
+static PQHandle allocateHandle(PriorityQueue queue);
+static bool isValidHandle(PriorityQueue queue, PQHandle handle);
+static void placeEntry(PriorityQueue queue, int index, HeapEntry entry);
+static void siftUp(PriorityQueue queue, int index);
+static void siftDown(PriorityQueue queue, int index);
+static void removeAt(PriorityQueue queue, int index);
+
+PriorityQueue pqCreate(copyPQElements copyElement, freePQElements freeElement,
+                       comparePQElementPriorities comparePriorities){
+    if(copyElement == NULL || freeElement == NULL || comparePriorities == NULL){
+        return NULL;
+    }
+    PriorityQueue queue = malloc(sizeof(*queue));
+    if(queue == NULL){
+        return NULL;
+    }
+    queue->heap = malloc(sizeof(*queue->heap) * INITIAL_CAPACITY);
+    queue->positions = malloc(sizeof(*queue->positions) * INITIAL_CAPACITY);
+    queue->free_handles = malloc(sizeof(*queue->free_handles) * INITIAL_CAPACITY);
+    if(queue->heap == NULL || queue->positions == NULL || queue->free_handles == NULL){
+        free(queue->heap);
+        free(queue->positions);
+        free(queue->free_handles);
+        free(queue);
+        return NULL;
+    }
+    queue->copyElementFunction = copyElement;
+    queue->freeElementFunction = freeElement;
+    queue->comparePrioritiesFunction = comparePriorities;
+    queue->size = 0;
+    queue->capacity = INITIAL_CAPACITY;
+    queue->handles_count = 0;
+    queue->free_handles_count = 0;
+    return queue;
+}
+
+void pqDestroy(PriorityQueue queue){
+    if(queue == NULL){
+        return;
+    }
+    pqClear(queue);
+    free(queue->heap);
+    free(queue->positions);
+    free(queue->free_handles);
+    free(queue);
+}
+
+int pqGetSize(PriorityQueue queue){
+    if(queue == NULL){
+        return NULL_ARGUMENT_INDICATOR;
+    }
+    return queue->size;
+}
+
+PriorityQueueResult pqPush(PriorityQueue queue, PQElement element, PQHandle *handle){
+    if(queue == NULL || element == NULL){
+        return PQ_NULL_ARGUMENT;
+    }
+    if(queue->size == queue->capacity && expandQueue(queue) != PQ_SUCCESS){
+        return PQ_OUT_OF_MEMORY;
+    }
+    PQElement new_element = queue->copyElementFunction(element);
+    if(new_element == NULL){
+        return PQ_OUT_OF_MEMORY;
+    }
+    HeapEntry entry = {new_element, allocateHandle(queue)};
+    int index = queue->size++;
+    placeEntry(queue, index, entry);
+    siftUp(queue, index);
+    if(handle != NULL){
+        *handle = entry.handle;
+    }
+    return PQ_SUCCESS;
+}
+
+PQElement pqPeek(PriorityQueue queue){
+    if(queue == NULL || queue->size == 0){
+        return NULL;
+    }
+    return queue->heap[0].element;
+}
+
+PQHandle pqPeekHandle(PriorityQueue queue){
+    if(queue == NULL || queue->size == 0){
+        return PQ_INVALID_HANDLE;
+    }
+    return queue->heap[0].handle;
+}
+
+PriorityQueueResult pqPop(PriorityQueue queue){
+    if(queue == NULL){
+        return PQ_NULL_ARGUMENT;
+    }
+    if(queue->size == 0){
+        return PQ_ITEM_DOES_NOT_EXIST;
+    }
+    removeAt(queue, 0);
+    return PQ_SUCCESS;
+}
+
+PQElement pqGet(PriorityQueue queue, PQHandle handle){
+    if(queue == NULL || !isValidHandle(queue, handle)){
+        return NULL;
+    }
+    return queue->heap[queue->positions[handle]].element;
+}
+
+PriorityQueueResult pqUpdateKey(PriorityQueue queue, PQHandle handle, PQElement element){
+    if(queue == NULL || element == NULL){
+        return PQ_NULL_ARGUMENT;
+    }
+    if(!isValidHandle(queue, handle)){
+        return PQ_ITEM_DOES_NOT_EXIST;
+    }
+    PQElement new_element = queue->copyElementFunction(element);
+    if(new_element == NULL){
+        return PQ_OUT_OF_MEMORY;
+    }
+    int index = queue->positions[handle];
+    queue->freeElementFunction(queue->heap[index].element);
+    queue->heap[index].element = new_element;
+    siftUp(queue, index);
+    siftDown(queue, queue->positions[handle]);
+    return PQ_SUCCESS;
+}
+
+PriorityQueueResult pqRemove(PriorityQueue queue, PQHandle handle){
+    if(queue == NULL){
+        return PQ_NULL_ARGUMENT;
+    }
+    if(!isValidHandle(queue, handle)){
+        return PQ_ITEM_DOES_NOT_EXIST;
+    }
+    removeAt(queue, queue->positions[handle]);
+    return PQ_SUCCESS;
+}
+
+PriorityQueueResult pqClear(PriorityQueue queue){
+    if(queue == NULL){
+        return PQ_NULL_ARGUMENT;
+    }
+    for(int i = 0; i < queue->size; i++){
+        queue->freeElementFunction(queue->heap[i].element);
+    }
+    queue->size = 0;
+    queue->handles_count = 0;
+    queue->free_handles_count = 0;
+    return PQ_SUCCESS;
+}
+
+/**
+ * Doubles the capacity of the heap and of the handle tables
+ * @param queue
+ * @return PQ_OUT_OF_MEMORY if an allocation failed, PQ_SUCCESS otherwise
+ */
+static PriorityQueueResult expandQueue(PriorityQueue queue){
+    int new_capacity = queue->capacity * EXPAND_FACTOR;
+    HeapEntry *heap = realloc(queue->heap, sizeof(*heap) * (size_t) new_capacity);
+    if(heap == NULL){
+        return PQ_OUT_OF_MEMORY;
+    }
+    queue->heap = heap;
+    int *positions = realloc(queue->positions, sizeof(*positions) * (size_t) new_capacity);
+    if(positions == NULL){
+        return PQ_OUT_OF_MEMORY;
+    }
+    queue->positions = positions;
+    PQHandle *free_handles = realloc(queue->free_handles, sizeof(*free_handles) * (size_t) new_capacity);
+    if(free_handles == NULL){
+        return PQ_OUT_OF_MEMORY;
+    }
+    queue->free_handles = free_handles;
+    queue->capacity = new_capacity;
+    return PQ_SUCCESS;
+}
+
+/**
+ * Returns an unused handle, preferring ones released by earlier removals.
+ * There is always room for it, since there are never more handles than heap slots.
+ * @param queue
+ * @return The new handle
+ */
+static PQHandle allocateHandle(PriorityQueue queue){
+    if(queue->free_handles_count > 0){
+        return queue->free_handles[--queue->free_handles_count];
+    }
+    return queue->handles_count++;
+}
+
+static bool isValidHandle(PriorityQueue queue, PQHandle handle){
+    return handle >= 0 && handle < queue->handles_count && queue->positions[handle] != FREE_HANDLE;
+}
+
+static void placeEntry(PriorityQueue queue, int index, HeapEntry entry){
+    queue->heap[index] = entry;
+    queue->positions[entry.handle] = index;
+}
+
+/**
+ * Moves the entry at a given index up until its parent has a priority at least as high
+ * @param queue
+ * @param index
+ */
+static void siftUp(PriorityQueue queue, int index){
+    HeapEntry entry = queue->heap[index];
+    while(index > 0){
+        int parent = (index - 1) / 2;
+        if(queue->comparePrioritiesFunction(entry.element, queue->heap[parent].element) <= 0){
+            break;
+        }
+        placeEntry(queue, index, queue->heap[parent]);
+        index = parent;
+    }
+    placeEntry(queue, index, entry);
+}
+
+/**
+ * Moves the entry at a given index down until both its children have a priority at most as high
+ * @param queue
+ * @param index
+ */
+static void siftDown(PriorityQueue queue, int index){
+    HeapEntry entry = queue->heap[index];
+    while(2 * index + 1 < queue->size){
+        int child = 2 * index + 1;
+        if(child + 1 < queue->size
+           && queue->comparePrioritiesFunction(queue->heap[child + 1].element, queue->heap[child].element) > 0){
+            child++;
+        }
+        if(queue->comparePrioritiesFunction(queue->heap[child].element, entry.element) <= 0){
+            break;
+        }
+        placeEntry(queue, index, queue->heap[child]);
+        index = child;
+    }
+    placeEntry(queue, index, entry);
+}
+
+/**
+ * Removes and frees the entry at a given index, releasing its handle
+ * @param queue
+ * @param index
+ */
+static void removeAt(PriorityQueue queue, int index){
+    HeapEntry removed = queue->heap[index];
+    queue->freeElementFunction(removed.element);
+    queue->positions[removed.handle] = FREE_HANDLE;
+    queue->free_handles[queue->free_handles_count++] = removed.handle;
+    queue->size--;
+    if(index == queue->size){
+        return;
+    }
+    HeapEntry moved = queue->heap[queue->size];
+    placeEntry(queue, index, moved);
+    siftUp(queue, index);
+    siftDown(queue, queue->positions[moved.handle]);
+}
@@ -0,0 +1,253 @@
+#include <stdlib.h>
+#include "headers/map.h"
+#include "headers/set.h"
+
+//Defines
+#define NULL_ARGUMENT_INDICATOR (-1)
+
+/**
+ * The set is a Map keyed by its elements. Every key is paired with the address of membership_marker,
+ * which the data functions below neither copy nor free, so no memory is spent on data elements.
+ */
+struct Set_t {
+    Map elements;
+    copySetElements copyElementFunction;
+    freeSetElements freeElementFunction;
+    compareSetElements compareElementsFunction;
+};
+
+static char membership_marker;
+
+static MapDataElement copyMembership(MapDataElement data);
+static void freeMembership(MapDataElement data);
+static SetResult convertMapResultToSetResult(MapResult map_result);
+static SetResult insertElements(Set target, Set source, Set filter);
+static void insertElement(MapKeyElement element, MapDataElement data, void *insertion);
+
+/** The state of insertElements, passed to insertElement for every element of the source set */
+typedef struct ElementsInsertion_t {
+    Set target;
+    Set filter;
+    SetResult result;
+} ElementsInsertion;
+
+static MapDataElement copyMembership(MapDataElement data){
+    return data;
+}
+
+static void freeMembership(MapDataElement data){
+    (void) data;
+}
+
+Set setCreate(copySetElements copyElement, freeSetElements freeElement, compareSetElements compareElements){
+    if(copyElement == NULL || freeElement == NULL || compareElements == NULL){
+        return NULL;
+    }
+    Set set = malloc(sizeof(*set));
+    if(set == NULL){
+        return NULL;
+    }
+    set->elements = mapCreate(copyMembership, copyElement, freeMembership, freeElement, compareElements);
+    if(set->elements == NULL){
+        free(set);
+        return NULL;
+    }
+    set->copyElementFunction = copyElement;
+    set->freeElementFunction = freeElement;
+    set->compareElementsFunction = compareElements;
+    return set;
+}
+
+void setDestroy(Set set){
+    if(set == NULL){
+        return;
+    }
+    mapDestroy(set->elements);
+    free(set);
+}
+
+Set setCopy(Set set){
+    if(set == NULL){
+        return NULL;
+    }
+    Set set_copy = malloc(sizeof(*set_copy));
+    if(set_copy == NULL){
+        return NULL;
+    }
+    set_copy->elements = mapCopy(set->elements);
+    if(set_copy->elements == NULL){
+        free(set_copy);
+        return NULL;
+    }
+    set_copy->copyElementFunction = set->copyElementFunction;
+    set_copy->freeElementFunction = set->freeElementFunction;
+    set_copy->compareElementsFunction = set->compareElementsFunction;
+    return set_copy;
+}
+
+int setGetSize(Set set){
+    if(set == NULL){
+        return NULL_ARGUMENT_INDICATOR;
+    }
+    return mapGetSize(set->elements);
+}
+
+bool setContains(Set set, SetElement element){
+    if(set == NULL){
+        return false;
+    }
+    return mapContains(set->elements, element);
+}
+
+SetResult setAdd(Set set, SetElement element){
+    if(set == NULL || element == NULL){
+        return SET_NULL_ARGUMENT;
+    }
+    // Putting an existing element only replaces its marker with itself, so the size tells whether it was new
+    int size = mapGetSize(set->elements);
+    SetResult result = convertMapResultToSetResult(mapPut(set->elements, element, &membership_marker));
+    if(result == SET_SUCCESS && mapGetSize(set->elements) == size){
+        return SET_ITEM_ALREADY_EXISTS;
+    }
+    return result;
+}
+
+SetResult setRemove(Set set, SetElement element){
+    if(set == NULL || element == NULL){
+        return SET_NULL_ARGUMENT;
+    }
+    return convertMapResultToSetResult(mapRemove(set->elements, element));
+}
+
+SetElement setGetFirst(Set set){
+    if(set == NULL){
+        return NULL;
+    }
+    return mapGetFirst(set->elements);
+}
+
+SetElement setGetNext(Set set){
+    if(set == NULL){
+        return NULL;
+    }
+    return mapGetNext(set->elements);
+}
+
+SetElement setGetByRank(Set set, int rank){
+    if(set == NULL){
+        return NULL;
+    }
+    return mapGetByRank(set->elements, rank);
+}
+
+int setRankOf(Set set, SetElement element){
+    if(set == NULL){
+        return NULL_ARGUMENT_INDICATOR;
+    }
+    return mapRankOf(set->elements, element);
+}
+
+SetResult setClear(Set set){
+    if(set == NULL){
+        return SET_NULL_ARGUMENT;
+    }
+    mapClear(set->elements);
+    return SET_SUCCESS;
+}
+
+Set setUnion(Set first, Set second){
+    if(first == NULL || second == NULL){
+        return NULL;
+    }
+    Set larger = setGetSize(first) >= setGetSize(second) ? first : second;
+    Set smaller = larger == first ? second : first;
+    Set united = setCopy(larger);
+    if(united == NULL){
+        return NULL;
+    }
+    if(insertElements(united, smaller, NULL) != SET_SUCCESS){
+        setDestroy(united);
+        return NULL;
+    }
+    return united;
+}
+
+Set setIntersect(Set first, Set second){
+    if(first == NULL || second == NULL){
+        return NULL;
+    }
+    Set larger = setGetSize(first) >= setGetSize(second) ? first : second;
+    Set smaller = larger == first ? second : first;
+    Set intersection = setCreate(first->copyElementFunction, first->freeElementFunction,
+                                 first->compareElementsFunction);
+    if(intersection == NULL){
+        return NULL;
+    }
+    if(insertElements(intersection, smaller, larger) != SET_SUCCESS){
+        setDestroy(intersection);
+        return NULL;
+    }
+    return intersection;
+}
+
+size_t setGetMemoryUsage(Set set, sizeOfSetElements elementSize){
+    MapMemoryUsage usage;
+    if(set == NULL || mapGetMemoryUsage(set->elements, elementSize, NULL, &usage) != MAP_SUCCESS){
+        return 0;
+    }
+    return sizeof(*set) + usage.structure + usage.keys;
+}
+
+/**
+ * Adds the elements of one set to another, skipping those missing from a filter set
+ * @param target - The set to add to
+ * @param source - The set whose elements are added
+ * @param filter - If not NULL, only elements it contains are added
+ * @return SET_OUT_OF_MEMORY if an allocation failed, SET_SUCCESS otherwise
+ */
+static SetResult insertElements(Set target, Set source, Set filter){
+    // The source is walked in place on the calling thread, so its elements are not copied and its iterator
+    // is left where it was
+    ElementsInsertion insertion = {target, filter, SET_SUCCESS};
+    mapParallelForEach(source->elements, insertElement, &insertion, 1);
+    return insertion.result;
+}
+
+/**
+ * Adds a single element of the source set to the target of an ElementsInsertion, unless an earlier
+ * element already failed
+ * @param element
+ * @param data
+ * @param insertion
+ */
+static void insertElement(MapKeyElement element, MapDataElement data, void *insertion){
+    (void) data;
+    ElementsInsertion *state = insertion;
+    if(state->result != SET_SUCCESS || (state->filter != NULL && !setContains(state->filter, element))){
+        return;
+    }
+    SetResult result = setAdd(state->target, element);
+    if(result != SET_ITEM_ALREADY_EXISTS){
+        state->result = result;
+    }
+}
+
+/**
+ * Translates Map result codes to SetResult
+ * @param map_result
+ * @return SetResult
+ */
+static SetResult convertMapResultToSetResult(MapResult map_result){
+    switch(map_result){
+        case MAP_OUT_OF_MEMORY:
+            return SET_OUT_OF_MEMORY;
+        case MAP_NULL_ARGUMENT:
+            return SET_NULL_ARGUMENT;
+        case MAP_ITEM_ALREADY_EXISTS:
+            return SET_ITEM_ALREADY_EXISTS;
+        case MAP_ITEM_DOES_NOT_EXIST:
+            return SET_ITEM_DOES_NOT_EXIST;
+        default:
+            return SET_SUCCESS;
+    }
+}
@@ -0,0 +1,145 @@
+#include "test_utilities.h"
+#include <limits.h>
+#include <stdlib.h>
+#include "../headers/intMap.h"
+
+#define NUMBER_TESTS 3
+#define KEYS_COUNT 5000
+
+/** Function to be used for copying an int as a data element of the map */
+static MapDataElement copyInt(MapDataElement n) {
+    if (!n) {
+        return NULL;
+    }
+    int *copy = malloc(sizeof(*copy));
+    if (!copy) {
+        return NULL;
+    }
+    *copy = *(int *) n;
+    return copy;
+}
+
+/** Function to be used by the map for freeing data elements */
+static void freeInt(MapDataElement n) {
+    free(n);
+}
+
+bool testIntMapPutGet() {
+    ASSERT_TEST(intMapCreate(copyInt, NULL) == NULL);
+    IntMap map = intMapCreate(copyInt, freeInt);
+    ASSERT_TEST(map != NULL);
+    ASSERT_TEST(intMapGetSize(map) == 0);
+    for (int i = 0; i < KEYS_COUNT; ++i) {
+        int key = (i * 7919) % KEYS_COUNT;
+        int data = key * 2;
+        ASSERT_TEST(intMapPut(map, key, &data) == MAP_SUCCESS);
+    }
+    ASSERT_TEST(intMapGetSize(map) == KEYS_COUNT);
+    for (int key = 0; key < KEYS_COUNT; ++key) {
+        int *data = intMapGet(map, key);
+        ASSERT_TEST(data != NULL && *data == key * 2);
+    }
+    ASSERT_TEST(!intMapContains(map, KEYS_COUNT));
+    ASSERT_TEST(!intMapContains(map, -1));
+    int data = 17;
+    ASSERT_TEST(intMapPut(map, 100, &data) == MAP_SUCCESS);
+    ASSERT_TEST(*(int *) intMapGet(map, 100) == 17);
+    ASSERT_TEST(intMapGetSize(map) == KEYS_COUNT);
+    ASSERT_TEST(intMapPut(map, INT_MAX, &data) == MAP_SUCCESS);
+    ASSERT_TEST(intMapPut(map, INT_MIN, &data) == MAP_SUCCESS);
+    ASSERT_TEST(intMapContains(map, INT_MAX) && intMapContains(map, INT_MIN));
+    ASSERT_TEST(intMapPut(map, 1, NULL) == MAP_NULL_ARGUMENT);
+    ASSERT_TEST(intMapGetSize(NULL) == -1);
+    intMapDestroy(map);
+    return true;
+}
+
+bool testIntMapRemove() {
+    IntMap map = intMapCreate(copyInt, freeInt);
+    for (int key = 0; key < KEYS_COUNT; ++key) {
+        ASSERT_TEST(intMapPut(map, key, &key) == MAP_SUCCESS);
+    }
+    for (int key = 0; key < KEYS_COUNT; ++key) {
+        if (key % 3 != 0) {
+            ASSERT_TEST(intMapRemove(map, key) == MAP_SUCCESS);
+        }
+    }
+    ASSERT_TEST(intMapRemove(map, 1) == MAP_ITEM_DOES_NOT_EXIST);
+    ASSERT_TEST(intMapGetSize(map) == (KEYS_COUNT + 2) / 3);
+    for (int key = 0; key < KEYS_COUNT; ++key) {
+        ASSERT_TEST(intMapContains(map, key) == (key % 3 == 0));
+    }
+    for (int key = 0; key < KEYS_COUNT; ++key) {
+        if (key % 3 == 1) {
+            ASSERT_TEST(intMapPut(map, key, &key) == MAP_SUCCESS);
+        }
+    }
+    ASSERT_TEST(intMapGetSize(map) == (KEYS_COUNT + 2) / 3 + (KEYS_COUNT + 1) / 3);
+    ASSERT_TEST(intMapClear(map) == MAP_SUCCESS);
+    ASSERT_TEST(intMapGetSize(map) == 0);
+    ASSERT_TEST(!intMapContains(map, 0));
+    ASSERT_TEST(intMapRemove(NULL, 0) == MAP_NULL_ARGUMENT);
+    intMapDestroy(map);
+    return true;
+}
+
+bool testIntMapIteration() {
+    IntMap map = intMapCreate(copyInt, freeInt);
+    int key;
+    ASSERT_TEST(!intMapGetFirst(map, &key));
+    for (int i = KEYS_COUNT; i > 0; --i) {
+        int shuffled = (i * 7919) % KEYS_COUNT - KEYS_COUNT / 2;
+        ASSERT_TEST(intMapPut(map, shuffled, &i) == MAP_SUCCESS);
+    }
+    // Empty a few leaves entirely, which the iterator has to skip
+    for (int i = 100; i < 200; ++i) {
+        ASSERT_TEST(intMapRemove(map, i) == MAP_SUCCESS);
+    }
+    int expected = -KEYS_COUNT / 2;
+    INT_MAP_FOREACH(iterator, map) {
+        if (expected == 100) {
+            expected = 200;
+        }
+        ASSERT_TEST(iterator == expected);
+        expected++;
+    }
+    ASSERT_TEST(expected == KEYS_COUNT - KEYS_COUNT / 2);
+    intMapDestroy(map);
+    return true;
+}
+
+/*The functions for the tests should be added here*/
+bool (*tests[]) (void) = {
+        testIntMapPutGet,
+        testIntMapRemove,
+        testIntMapIteration
+};
+
+/*The names of the test functions should be added here*/
+const char* testNames[] = {
+        "testIntMapPutGet",
+        "testIntMapRemove",
+        "testIntMapIteration"
+};
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        for (int test_idx = 0; test_idx < NUMBER_TESTS; test_idx++) {
+            RUN_TEST(tests[test_idx], testNames[test_idx]);
+        }
+        return 0;
+    }
+    if (argc != 2) {
+        fprintf(stdout, "Usage: <your_executable_file_name> <test index>\n");
+        return 0;
+    }
+
+    int test_idx = (int) strtol(argv[1], NULL, 10);
+    if (test_idx < 1 || test_idx > NUMBER_TESTS) {
+        fprintf(stderr, "Invalid test index %d\n", test_idx);
+        return 0;
+    }
+
+    RUN_TEST(tests[test_idx - 1], testNames[test_idx - 1]);
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include "test_utilities.h"
 #include <stdlib.h>
+#include <string.h>
 #include "../headers/map.h"
 
 static long NumTestsPassed = 0;
@@ -469,6 +470,365 @@ static bool testSorting()
     return true;
 }
 
+bool testRank()
+{
+    Map map = mapCreate(copyDataChar, copyKeyInt, freeChar, freeInt,
+                        compareInts);
+    ASSERT_TEST(map != NULL);
+    ASSERT_TEST(mapGetByRank(map, 0) == NULL);
+    ASSERT_TEST(mapRankOf(NULL, NULL) == -1);
+    char data = 'a';
+    // Insert the even numbers 0..998 in a scrambled order
+    for (int i = 0; i < 500; ++i) {
+        int key = ((i * 37) % 500) * 2;
+        ASSERT_TEST(mapPut(map, &key, &data) == MAP_SUCCESS);
+    }
+    for (int rank = 0; rank < 500; ++rank) {
+        int *key = mapGetByRank(map, rank);
+        ASSERT_TEST(key != NULL);
+        ASSERT_TEST(*key == rank * 2);
+        ASSERT_TEST(mapRankOf(map, key) == rank);
+        freeInt(key);
+        int odd = rank * 2 + 1;
+        ASSERT_TEST(mapRankOf(map, &odd) == rank + 1);
+    }
+    ASSERT_TEST(mapGetByRank(map, 500) == NULL);
+    ASSERT_TEST(mapGetByRank(map, -1) == NULL);
+
+    for (int key = 0; key < 1000; key += 4) {
+        ASSERT_TEST(mapRemove(map, &key) == MAP_SUCCESS);
+    }
+    ASSERT_TEST(isMapSorted(map));
+    for (int rank = 0; rank < 250; ++rank) {
+        int *key = mapGetByRank(map, rank);
+        ASSERT_TEST(*key == rank * 4 + 2);
+        freeInt(key);
+    }
+    mapDestroy(map);
+    return true;
+}
+
+bool testBoundedMap()
+{
+    ASSERT_TEST(mapCreateBounded(0, copyDataChar, copyKeyInt, freeChar, freeInt, compareInts) == NULL);
+    Map map = mapCreateBounded(3, copyDataChar, copyKeyInt, freeChar, freeInt,
+                               compareInts);
+    ASSERT_TEST(map != NULL);
+    char data = 'a';
+    for (int i = 1; i <= 3; ++i) {
+        ASSERT_TEST(mapPut(map, &i, &data) == MAP_SUCCESS);
+    }
+    ASSERT_TEST(mapGetSize(map) == 3);
+    // All three were just used, so the clock sweeps once and evicts 1. Then 2 is the oldest.
+    int key = 4;
+    ASSERT_TEST(mapPut(map, &key, &data) == MAP_SUCCESS);
+    ASSERT_TEST(mapGetSize(map) == 3);
+    key = 1;
+    ASSERT_TEST(!mapContains(map, &key));
+    key = 2;
+    ASSERT_TEST(mapGet(map, &key) != NULL);
+    key = 5;
+    ASSERT_TEST(mapPut(map, &key, &data) == MAP_SUCCESS);
+    key = 3;
+    ASSERT_TEST(!mapContains(map, &key));
+    key = 2;
+    ASSERT_TEST(mapContains(map, &key));
+    ASSERT_TEST(mapGetSize(map) == 3);
+    ASSERT_TEST(isMapSorted(map));
+    for (int i = 10; i < 100; ++i) {
+        ASSERT_TEST(mapPut(map, &i, &data) == MAP_SUCCESS);
+        ASSERT_TEST(mapGetSize(map) == 3);
+    }
+    mapDestroy(map);
+
+    // The hand moves past the entries it spares, so entries used between evictions get their second chance
+    map = mapCreateBounded(5, copyDataChar, copyKeyInt, freeChar, freeInt, compareInts);
+    for (int i = 1; i <= 6; ++i) {
+        ASSERT_TEST(mapPut(map, &i, &data) == MAP_SUCCESS);
+    }
+    key = 2;
+    ASSERT_TEST(mapGet(map, &key) != NULL);
+    key = 4;
+    ASSERT_TEST(mapGet(map, &key) != NULL);
+    for (int i = 7; i <= 8; ++i) {
+        ASSERT_TEST(mapPut(map, &i, &data) == MAP_SUCCESS);
+    }
+    int expected_keys[] = {2, 4, 6, 7, 8};
+    int index = 0;
+    MAP_FOREACH(int *, iterator, map) {
+        ASSERT_TEST(*iterator == expected_keys[index++]);
+        freeInt(iterator);
+    }
+    ASSERT_TEST(index == 5);
+    mapDestroy(map);
+
+    map = mapCreateBounded(2, copyDataChar, copyKeyInt, freeChar, freeInt, compareInts);
+    Map copy = mapCopy(map);
+    ASSERT_TEST(copy != NULL);
+    for (int i = 1; i <= 5; ++i) {
+        ASSERT_TEST(mapPut(copy, &i, &data) == MAP_SUCCESS);
+    }
+    ASSERT_TEST(mapGetSize(copy) == 2);
+    mapDestroy(copy);
+    mapDestroy(map);
+    return true;
+}
+
+static void sumKeys(void *accumulator, MapKeyElement key, MapDataElement data) {
+    (void) data;
+    *(long *) accumulator += *(int *) key;
+}
+
+static void addSums(void *accumulator, void *other) {
+    *(long *) accumulator += *(long *) other;
+}
+
+static void markKey(MapKeyElement key, MapDataElement data, void *context) {
+    (void) data;
+    ((char *) context)[*(int *) key] = 1;
+}
+
+bool testParallelScan()
+{
+    Map map = mapCreate(copyDataChar, copyKeyInt, freeChar, freeInt,
+                        compareInts);
+    char data = 'a';
+    const int size = 10000;
+    for (int i = 0; i < size; ++i) {
+        ASSERT_TEST(mapPut(map, &i, &data) == MAP_SUCCESS);
+    }
+    char *seen = calloc((size_t) size, 1);
+    ASSERT_TEST(mapParallelForEach(map, markKey, seen, 8) == MAP_SUCCESS);
+    for (int i = 0; i < size; ++i) {
+        ASSERT_TEST(seen[i] == 1);
+    }
+    free(seen);
+
+    long sums[8] = {0};
+    ASSERT_TEST(mapParallelReduce(map, sumKeys, addSums, sums, sizeof(*sums), 8) == MAP_SUCCESS);
+    ASSERT_TEST(sums[0] == (long) size * (size - 1) / 2);
+
+    // Without combine, every range keeps its own accumulator, in key order
+    long chunks[3] = {0};
+    ASSERT_TEST(mapParallelReduce(map, sumKeys, NULL, chunks, sizeof(*chunks), 3) == MAP_SUCCESS);
+    ASSERT_TEST(chunks[0] < chunks[1] && chunks[1] < chunks[2]);
+    ASSERT_TEST(chunks[0] + chunks[1] + chunks[2] == (long) size * (size - 1) / 2);
+
+    long single = 0;
+    ASSERT_TEST(mapParallelReduce(map, sumKeys, addSums, &single, sizeof(single), 1) == MAP_SUCCESS);
+    ASSERT_TEST(single == (long) size * (size - 1) / 2);
+    ASSERT_TEST(mapParallelForEach(NULL, markKey, NULL, 2) == MAP_NULL_ARGUMENT);
+    mapDestroy(map);
+    return true;
+}
+
+typedef struct {
+    int added;
+    int removed;
+    int changed;
+    int unexpected;
+} DiffCounters;
+
+static void countAdded(MapKeyElement key, MapDataElement data, void *context) {
+    (void) data;
+    if (*(int *) key % 3 == 0) {
+        ((DiffCounters *) context)->added++;
+    } else {
+        ((DiffCounters *) context)->unexpected++;
+    }
+}
+
+static void countRemoved(MapKeyElement key, MapDataElement data, void *context) {
+    (void) data;
+    if (*(int *) key % 5 == 0) {
+        ((DiffCounters *) context)->removed++;
+    } else {
+        ((DiffCounters *) context)->unexpected++;
+    }
+}
+
+static void countChanged(MapKeyElement key, MapDataElement old_data, MapDataElement new_data, void *context) {
+    if (*(int *) key % 7 == 0 && *(char *) old_data != *(char *) new_data) {
+        ((DiffCounters *) context)->changed++;
+    } else {
+        ((DiffCounters *) context)->unexpected++;
+    }
+}
+
+static bool equalChars(MapDataElement first, MapDataElement second) {
+    return *(char *) first == *(char *) second;
+}
+
+bool testDiff()
+{
+    Map before = mapCreate(copyDataChar, copyKeyInt, freeChar, freeInt,
+                           compareInts);
+    char data = 'a', changed_data = 'b';
+    for (int i = 1; i <= 100; ++i) {
+        if (i % 3 != 0) {
+            ASSERT_TEST(mapPut(before, &i, &data) == MAP_SUCCESS);
+        }
+    }
+    Map after = mapCopy(before);
+    DiffCounters counters = {0, 0, 0, 0};
+    ASSERT_TEST(mapDiff(before, after, countAdded, countRemoved, countChanged, equalChars, &counters) == MAP_SUCCESS);
+    ASSERT_TEST(counters.added == 0 && counters.removed == 0 && counters.changed == 0);
+    ASSERT_TEST(counters.unexpected == 0);
+
+    for (int i = 1; i <= 100; ++i) {
+        if (i % 3 == 0) {
+            ASSERT_TEST(mapPut(after, &i, &data) == MAP_SUCCESS);
+        } else if (i % 5 == 0) {
+            ASSERT_TEST(mapRemove(after, &i) == MAP_SUCCESS);
+        } else if (i % 7 == 0) {
+            ASSERT_TEST(mapPut(after, &i, &changed_data) == MAP_SUCCESS);
+        }
+    }
+    ASSERT_TEST(mapDiff(before, after, countAdded, countRemoved, countChanged, equalChars, &counters) == MAP_SUCCESS);
+    ASSERT_TEST(counters.added == 33);
+    ASSERT_TEST(counters.removed == 14);
+    ASSERT_TEST(counters.changed == 8);
+    ASSERT_TEST(counters.unexpected == 0);
+    ASSERT_TEST(mapDiff(before, after, NULL, NULL, countChanged, NULL, NULL) == MAP_NULL_ARGUMENT);
+    mapDestroy(before);
+    mapDestroy(after);
+    return true;
+}
+
+bool testCompact()
+{
+    Map map = mapCreate(copyDataChar, copyKeyInt, freeChar, freeInt,
+                        compareInts);
+    ASSERT_TEST(mapCompact(map) == MAP_SUCCESS);
+    char data = 'a';
+    for (int i = 0; i < 1000; ++i) {
+        int key = (i * 37) % 1000;
+        ASSERT_TEST(mapPut(map, &key, &data) == MAP_SUCCESS);
+    }
+    for (int key = 0; key < 1000; key += 2) {
+        ASSERT_TEST(mapRemove(map, &key) == MAP_SUCCESS);
+    }
+    int *first = mapGetFirst(map);
+    ASSERT_TEST(*first == 1);
+    freeInt(first);
+    ASSERT_TEST(mapCompact(map) == MAP_SUCCESS);
+    // The iterator survives compaction
+    int *next = mapGetNext(map);
+    ASSERT_TEST(*next == 3);
+    freeInt(next);
+    ASSERT_TEST(mapGetSize(map) == 500);
+    ASSERT_TEST(isMapSorted(map));
+    for (int key = 0; key < 1000; ++key) {
+        ASSERT_TEST(mapContains(map, &key) == (key % 2 == 1));
+    }
+    for (int rank = 0; rank < 500; ++rank) {
+        int *key = mapGetByRank(map, rank);
+        ASSERT_TEST(*key == rank * 2 + 1);
+        freeInt(key);
+    }
+    for (int key = 0; key < 1000; key += 2) {
+        ASSERT_TEST(mapPut(map, &key, &data) == MAP_SUCCESS);
+    }
+    ASSERT_TEST(mapGetSize(map) == 1000);
+    ASSERT_TEST(isMapSorted(map));
+    ASSERT_TEST(mapCompact(NULL) == MAP_NULL_ARGUMENT);
+    mapDestroy(map);
+    return true;
+}
+
+static size_t sizeOfInt(MapKeyElement n) {
+    (void) n;
+    return sizeof(int);
+}
+
+static size_t sizeOfChar(MapDataElement c) {
+    (void) c;
+    return sizeof(char);
+}
+
+bool testMemoryUsage()
+{
+    Map map = mapCreate(copyDataChar, copyKeyInt, freeChar, freeInt,
+                        compareInts);
+    MapMemoryUsage empty_usage;
+    ASSERT_TEST(mapGetMemoryUsage(map, sizeOfInt, sizeOfChar, &empty_usage) == MAP_SUCCESS);
+    ASSERT_TEST(empty_usage.keys == 0 && empty_usage.values == 0);
+    char data = 'a';
+    for (int key = 0; key < 100; ++key) {
+        ASSERT_TEST(mapPut(map, &key, &data) == MAP_SUCCESS);
+    }
+    MapMemoryUsage usage;
+    ASSERT_TEST(mapGetMemoryUsage(map, sizeOfInt, sizeOfChar, &usage) == MAP_SUCCESS);
+    ASSERT_TEST(usage.keys == 100 * sizeof(int));
+    ASSERT_TEST(usage.values == 100 * sizeof(char));
+    ASSERT_TEST(usage.structure > empty_usage.structure);
+    ASSERT_TEST(mapGetMemoryUsage(map, NULL, NULL, &usage) == MAP_SUCCESS);
+    ASSERT_TEST(usage.keys == 0 && usage.values == 0);
+    ASSERT_TEST(mapGetMemoryUsage(map, NULL, NULL, NULL) == MAP_NULL_ARGUMENT);
+    mapClear(map);
+    ASSERT_TEST(mapGetMemoryUsage(map, sizeOfInt, sizeOfChar, &usage) == MAP_SUCCESS);
+    ASSERT_TEST(usage.structure == empty_usage.structure);
+    mapDestroy(map);
+    return true;
+}
+
+static void countStringKey(MapKeyElement key, MapDataElement data, void *count) {
+    (void) data;
+    if (strncmp(key, "a long common prefix shared by all keys ", 40) == 0) {
+        ++*(int *) count;
+    }
+}
+
+bool testStringKeys()
+{
+    ASSERT_TEST(mapCreateStringKeys(copyDataChar, NULL) == NULL);
+    Map map = mapCreateStringKeys(copyDataChar, freeChar);
+    ASSERT_TEST(map != NULL);
+    char key[64];
+    char data = 'a';
+    for (int i = 0; i < 300; ++i) {
+        sprintf(key, "a long common prefix shared by all keys %d", i);
+        ASSERT_TEST(mapPut(map, key, &data) == MAP_SUCCESS);
+    }
+    ASSERT_TEST(mapGetSize(map) == 300);
+    for (int i = 0; i < 300; ++i) {
+        sprintf(key, "a long common prefix shared by all keys %d", i);
+        ASSERT_TEST(mapContains(map, key));
+        ASSERT_TEST(*(char *) mapGet(map, key) == 'a');
+    }
+    ASSERT_TEST(!mapContains(map, "a long common prefix shared by all keys "));
+    ASSERT_TEST(!mapContains(map, ""));
+    char changed_data = 'b';
+    ASSERT_TEST(mapPut(map, "a long common prefix shared by all keys 7", &changed_data) == MAP_SUCCESS);
+    ASSERT_TEST(*(char *) mapGet(map, "a long common prefix shared by all keys 7") == 'b');
+    ASSERT_TEST(mapGetSize(map) == 300);
+
+    int iterated = 0;
+    MAP_FOREACH(char *, iterator, map) {
+        ASSERT_TEST(mapContains(map, iterator));
+        ASSERT_TEST(mapRankOf(map, iterator) == iterated);
+        free(iterator);
+        iterated++;
+    }
+    ASSERT_TEST(iterated == 300);
+    int counted = 0;
+    ASSERT_TEST(mapParallelForEach(map, countStringKey, &counted, 1) == MAP_SUCCESS);
+    ASSERT_TEST(counted == 300);
+
+    Map copy = mapCopy(map);
+    for (int i = 0; i < 300; i += 2) {
+        sprintf(key, "a long common prefix shared by all keys %d", i);
+        ASSERT_TEST(mapRemove(map, key) == MAP_SUCCESS);
+        ASSERT_TEST(mapRemove(map, key) == MAP_ITEM_DOES_NOT_EXIST);
+    }
+    ASSERT_TEST(mapGetSize(map) == 150);
+    ASSERT_TEST(mapGetSize(copy) == 300);
+    ASSERT_TEST(mapContains(copy, "a long common prefix shared by all keys 0"));
+    mapDestroy(copy);
+    mapDestroy(map);
+    return true;
+}
+
 /*The functions for the tests should be added here*/
 bool (*tests[]) (void) = {
         testCreateNulls,
@@ -482,6 +842,13 @@ bool (*tests[]) (void) = {
         testGetFirstGetNext,
         testContains,
         testSorting,
+        testRank,
+        testBoundedMap,
+        testParallelScan,
+        testDiff,
+        testCompact,
+        testMemoryUsage,
+        testStringKeys,
 };
 
 #define NUMBER_TESTS ((long)(sizeof(tests)/sizeof(*tests)))
@@ -500,6 +867,13 @@ const char* testNames[NUMBER_TESTS] = {
         "testGetFirstGetNext",
         "testContains",
         "testSorting",
+        "testRank",
+        "testBoundedMap",
+        "testParallelScan",
+        "testDiff",
+        "testCompact",
+        "testMemoryUsage",
+        "testStringKeys",
 };
 
 
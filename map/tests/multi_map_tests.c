@@ -0,0 +1,182 @@
+#include "test_utilities.h"
+#include <stdlib.h>
+#include "../headers/multiMap.h"
+
+#define NUMBER_TESTS 4
+
+/** Function to be used for copying an int as a key or a value of the multi map */
+static void *copyInt(void *n) {
+    if (!n) {
+        return NULL;
+    }
+    int *copy = malloc(sizeof(*copy));
+    if (!copy) {
+        return NULL;
+    }
+    *copy = *(int *) n;
+    return copy;
+}
+
+/** Function to be used by the multi map for freeing keys and values */
+static void freeInt(void *n) {
+    free(n);
+}
+
+/** Function to be used by the multi map for comparing keys */
+static int compareInts(void *n1, void *n2) {
+    return (*(int *) n1 - *(int *) n2);
+}
+
+/** Function to be used by the multi map for finding values */
+static bool equalInts(void *n1, void *n2) {
+    return *(int *) n1 == *(int *) n2;
+}
+
+/** Function to be used by the multi map for measuring keys and values */
+static size_t sizeOfInt(void *n) {
+    (void) n;
+    return sizeof(int);
+}
+
+static MultiMap createIntMultiMap() {
+    return multiMapCreate(copyInt, freeInt, compareInts, copyInt, freeInt, equalInts);
+}
+
+bool testAppendAndGetValues() {
+    ASSERT_TEST(multiMapCreate(copyInt, freeInt, compareInts, copyInt, freeInt, NULL) == NULL);
+    MultiMap multiMap = createIntMultiMap();
+    ASSERT_TEST(multiMap != NULL);
+    for (int value = 0; value < 100; ++value) {
+        int key = value % 10;
+        ASSERT_TEST(multiMapAppend(multiMap, &key, &value) == MULTIMAP_SUCCESS);
+    }
+    ASSERT_TEST(multiMapGetSize(multiMap) == 10);
+    for (int key = 0; key < 10; ++key) {
+        int count = 0;
+        MultiMapValueElement *values = multiMapGetValues(multiMap, &key, &count);
+        ASSERT_TEST(count == 10);
+        for (int i = 0; i < count; ++i) {
+            ASSERT_TEST(*(int *) values[i] == key + 10 * i);
+        }
+    }
+    int missing = 10, count = -1;
+    ASSERT_TEST(multiMapGetValues(multiMap, &missing, &count) == NULL);
+    ASSERT_TEST(count == 0);
+    multiMapDestroy(multiMap);
+    return true;
+}
+
+bool testRemoveValues() {
+    MultiMap multiMap = createIntMultiMap();
+    int key = 1;
+    for (int value = 0; value < 5; ++value) {
+        ASSERT_TEST(multiMapAppend(multiMap, &key, &value) == MULTIMAP_SUCCESS);
+    }
+    int value = 2;
+    ASSERT_TEST(multiMapRemoveValue(multiMap, &key, &value) == MULTIMAP_SUCCESS);
+    ASSERT_TEST(multiMapRemoveValue(multiMap, &key, &value) == MULTIMAP_ITEM_DOES_NOT_EXIST);
+    int count = 0;
+    MultiMapValueElement *values = multiMapGetValues(multiMap, &key, &count);
+    ASSERT_TEST(count == 4);
+    ASSERT_TEST(*(int *) values[2] == 4);
+    ASSERT_TEST(multiMapRemoveValueAt(multiMap, &key, 4) == MULTIMAP_ITEM_DOES_NOT_EXIST);
+    int last = 5;
+    ASSERT_TEST(multiMapAppend(multiMap, &key, &last) == MULTIMAP_SUCCESS);
+    ASSERT_TEST(multiMapRemoveLastValue(multiMap, &key) == MULTIMAP_SUCCESS);
+    values = multiMapGetValues(multiMap, &key, &count);
+    ASSERT_TEST(count == 4);
+    ASSERT_TEST(*(int *) values[3] == 3);
+    while (count > 0) {
+        ASSERT_TEST(multiMapRemoveValueAt(multiMap, &key, 0) == MULTIMAP_SUCCESS);
+        multiMapGetValues(multiMap, &key, &count);
+    }
+    ASSERT_TEST(!multiMapContains(multiMap, &key));
+    ASSERT_TEST(multiMapGetSize(multiMap) == 0);
+    multiMapDestroy(multiMap);
+    return true;
+}
+
+bool testKeysIteration() {
+    MultiMap multiMap = createIntMultiMap();
+    for (int key = 20; key > 0; --key) {
+        ASSERT_TEST(multiMapAppend(multiMap, &key, &key) == MULTIMAP_SUCCESS);
+    }
+    int expected = 1;
+    MULTIMAP_FOREACH(int *, iterator, multiMap) {
+        ASSERT_TEST(*iterator == expected);
+        freeInt(iterator);
+        expected++;
+    }
+    ASSERT_TEST(expected == 21);
+    int key = 7;
+    ASSERT_TEST(multiMapRemoveKey(multiMap, &key) == MULTIMAP_SUCCESS);
+    ASSERT_TEST(multiMapRemoveKey(multiMap, &key) == MULTIMAP_ITEM_DOES_NOT_EXIST);
+    ASSERT_TEST(multiMapClear(multiMap) == MULTIMAP_SUCCESS);
+    ASSERT_TEST(multiMapGetSize(multiMap) == 0);
+    multiMapDestroy(multiMap);
+    return true;
+}
+
+bool testMemoryUsage() {
+    MultiMap multiMap = createIntMultiMap();
+    ASSERT_TEST(multiMapGetMemoryUsage(NULL, sizeOfInt, sizeOfInt) == 0);
+    size_t empty = multiMapGetMemoryUsage(multiMap, sizeOfInt, sizeOfInt);
+    ASSERT_TEST(empty > 0);
+    for (int key = 1; key <= 2; ++key) {
+        for (int value = 0; value < 5; ++value) {
+            ASSERT_TEST(multiMapAppend(multiMap, &key, &value) == MULTIMAP_SUCCESS);
+        }
+    }
+    // Two keys and ten values, next to lists that grew past their initial capacity
+    size_t counted = multiMapGetMemoryUsage(multiMap, sizeOfInt, sizeOfInt);
+    size_t uncounted = multiMapGetMemoryUsage(multiMap, NULL, NULL);
+    ASSERT_TEST(counted - uncounted == 12 * sizeof(int));
+    ASSERT_TEST(uncounted > empty + 2 * 5 * sizeof(void *));
+    // Measuring does not move the iterator
+    int *first = multiMapGetFirst(multiMap);
+    ASSERT_TEST(multiMapGetMemoryUsage(multiMap, sizeOfInt, sizeOfInt) == counted);
+    int *second = multiMapGetNext(multiMap);
+    ASSERT_TEST(first != NULL && *first == 1 && second != NULL && *second == 2);
+    freeInt(first);
+    freeInt(second);
+    multiMapDestroy(multiMap);
+    return true;
+}
+
+/*The functions for the tests should be added here*/
+bool (*tests[]) (void) = {
+        testAppendAndGetValues,
+        testRemoveValues,
+        testKeysIteration,
+        testMemoryUsage
+};
+
+/*The names of the test functions should be added here*/
+const char* testNames[] = {
+        "testAppendAndGetValues",
+        "testRemoveValues",
+        "testKeysIteration",
+        "testMemoryUsage"
+};
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        for (int test_idx = 0; test_idx < NUMBER_TESTS; test_idx++) {
+            RUN_TEST(tests[test_idx], testNames[test_idx]);
+        }
+        return 0;
+    }
+    if (argc != 2) {
+        fprintf(stdout, "Usage: <your_executable_file_name> <test index>\n");
+        return 0;
+    }
+
+    int test_idx = (int) strtol(argv[1], NULL, 10);
+    if (test_idx < 1 || test_idx > NUMBER_TESTS) {
+        fprintf(stderr, "Invalid test index %d\n", test_idx);
+        return 0;
+    }
+
+    RUN_TEST(tests[test_idx - 1], testNames[test_idx - 1]);
+    return 0;
+}
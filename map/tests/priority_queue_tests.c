@@ -0,0 +1,127 @@
+#include "test_utilities.h"
+#include <stdlib.h>
+#include "../headers/priorityQueue.h"
+
+#define NUMBER_TESTS 3
+
+/** Function to be used for copying an int as an element of the queue */
+static PQElement copyInt(PQElement n) {
+    if (!n) {
+        return NULL;
+    }
+    int *copy = malloc(sizeof(*copy));
+    if (!copy) {
+        return NULL;
+    }
+    *copy = *(int *) n;
+    return copy;
+}
+
+/** Function to be used by the queue for freeing elements */
+static void freeInt(PQElement n) {
+    free(n);
+}
+
+/** Function to be used by the queue for comparing elements, the greater int comes first */
+static int compareInts(PQElement n1, PQElement n2) {
+    return (*(int *) n1 - *(int *) n2);
+}
+
+bool testPushPeekPop() {
+    ASSERT_TEST(pqCreate(NULL, freeInt, compareInts) == NULL);
+    PriorityQueue queue = pqCreate(copyInt, freeInt, compareInts);
+    ASSERT_TEST(queue != NULL);
+    ASSERT_TEST(pqPeek(queue) == NULL);
+    ASSERT_TEST(pqPop(queue) == PQ_ITEM_DOES_NOT_EXIST);
+    for (int i = 0; i < 1000; ++i) {
+        int value = (i * 7919) % 1000;
+        ASSERT_TEST(pqPush(queue, &value, NULL) == PQ_SUCCESS);
+    }
+    ASSERT_TEST(pqGetSize(queue) == 1000);
+    for (int expected = 999; expected >= 0; --expected) {
+        ASSERT_TEST(*(int *) pqPeek(queue) == expected);
+        ASSERT_TEST(pqPop(queue) == PQ_SUCCESS);
+    }
+    ASSERT_TEST(pqGetSize(queue) == 0);
+    pqDestroy(queue);
+    return true;
+}
+
+bool testUpdateKey() {
+    PriorityQueue queue = pqCreate(copyInt, freeInt, compareInts);
+    PQHandle handles[100];
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TEST(pqPush(queue, &i, &handles[i]) == PQ_SUCCESS);
+    }
+    int value = 1000;
+    ASSERT_TEST(pqUpdateKey(queue, handles[3], &value) == PQ_SUCCESS);
+    ASSERT_TEST(pqPeekHandle(queue) == handles[3]);
+    value = -1;
+    ASSERT_TEST(pqUpdateKey(queue, handles[3], &value) == PQ_SUCCESS);
+    ASSERT_TEST(*(int *) pqPeek(queue) == 99);
+    ASSERT_TEST(*(int *) pqGet(queue, handles[3]) == -1);
+    for (int i = 0; i < 99; ++i) {
+        ASSERT_TEST(pqPop(queue) == PQ_SUCCESS);
+    }
+    ASSERT_TEST(pqPeekHandle(queue) == handles[3]);
+    ASSERT_TEST(pqUpdateKey(queue, PQ_INVALID_HANDLE, &value) == PQ_ITEM_DOES_NOT_EXIST);
+    pqDestroy(queue);
+    return true;
+}
+
+bool testRemoveByHandle() {
+    PriorityQueue queue = pqCreate(copyInt, freeInt, compareInts);
+    PQHandle handles[50];
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TEST(pqPush(queue, &i, &handles[i]) == PQ_SUCCESS);
+    }
+    for (int i = 0; i < 50; i += 2) {
+        ASSERT_TEST(pqRemove(queue, handles[i]) == PQ_SUCCESS);
+    }
+    ASSERT_TEST(pqRemove(queue, handles[0]) == PQ_ITEM_DOES_NOT_EXIST);
+    ASSERT_TEST(pqGet(queue, handles[0]) == NULL);
+    ASSERT_TEST(pqGetSize(queue) == 25);
+    for (int expected = 49; expected > 0; expected -= 2) {
+        ASSERT_TEST(*(int *) pqPeek(queue) == expected);
+        ASSERT_TEST(pqPop(queue) == PQ_SUCCESS);
+    }
+    ASSERT_TEST(pqClear(queue) == PQ_SUCCESS);
+    pqDestroy(queue);
+    return true;
+}
+
+/*The functions for the tests should be added here*/
+bool (*tests[]) (void) = {
+        testPushPeekPop,
+        testUpdateKey,
+        testRemoveByHandle
+};
+
+/*The names of the test functions should be added here*/
+const char* testNames[] = {
+        "testPushPeekPop",
+        "testUpdateKey",
+        "testRemoveByHandle"
+};
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        for (int test_idx = 0; test_idx < NUMBER_TESTS; test_idx++) {
+            RUN_TEST(tests[test_idx], testNames[test_idx]);
+        }
+        return 0;
+    }
+    if (argc != 2) {
+        fprintf(stdout, "Usage: <your_executable_file_name> <test index>\n");
+        return 0;
+    }
+
+    int test_idx = (int) strtol(argv[1], NULL, 10);
+    if (test_idx < 1 || test_idx > NUMBER_TESTS) {
+        fprintf(stderr, "Invalid test index %d\n", test_idx);
+        return 0;
+    }
+
+    RUN_TEST(tests[test_idx - 1], testNames[test_idx - 1]);
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include "test_utilities.h"
+#include <stdlib.h>
+#include "../headers/set.h"
+
+#define NUMBER_TESTS 3
+
+/** Function to be used for copying an int as an element of the set */
+static SetElement copyInt(SetElement n) {
+    if (!n) {
+        return NULL;
+    }
+    int *copy = malloc(sizeof(*copy));
+    if (!copy) {
+        return NULL;
+    }
+    *copy = *(int *) n;
+    return copy;
+}
+
+/** Function to be used by the set for freeing elements */
+static void freeInt(SetElement n) {
+    free(n);
+}
+
+/** Function to be used by the set for comparing elements */
+static int compareInts(SetElement n1, SetElement n2) {
+    return (*(int *) n1 - *(int *) n2);
+}
+
+bool testSetAddRemove() {
+    ASSERT_TEST(setCreate(copyInt, NULL, compareInts) == NULL);
+    Set set = setCreate(copyInt, freeInt, compareInts);
+    ASSERT_TEST(set != NULL);
+    ASSERT_TEST(setGetSize(set) == 0);
+    for (int i = 0; i < 100; ++i) {
+        int element = (i * 37) % 100;
+        ASSERT_TEST(setAdd(set, &element) == SET_SUCCESS);
+    }
+    int element = 42;
+    ASSERT_TEST(setAdd(set, &element) == SET_ITEM_ALREADY_EXISTS);
+    ASSERT_TEST(setGetSize(set) == 100);
+    ASSERT_TEST(setContains(set, &element));
+    ASSERT_TEST(setRemove(set, &element) == SET_SUCCESS);
+    ASSERT_TEST(!setContains(set, &element));
+    ASSERT_TEST(setRemove(set, &element) == SET_ITEM_DOES_NOT_EXIST);
+    ASSERT_TEST(setAdd(set, NULL) == SET_NULL_ARGUMENT);
+    ASSERT_TEST(setGetMemoryUsage(set, NULL) > 0);
+    ASSERT_TEST(setGetMemoryUsage(NULL, NULL) == 0);
+    setDestroy(set);
+    return true;
+}
+
+bool testSetIteration() {
+    Set set = setCreate(copyInt, freeInt, compareInts);
+    for (int i = 50; i > 0; --i) {
+        ASSERT_TEST(setAdd(set, &i) == SET_SUCCESS);
+    }
+    int expected = 1;
+    SET_FOREACH(int *, iterator, set) {
+        ASSERT_TEST(*iterator == expected);
+        freeInt(iterator);
+        expected++;
+    }
+    ASSERT_TEST(expected == 51);
+    int *element = setGetByRank(set, 9);
+    ASSERT_TEST(element != NULL && *element == 10);
+    ASSERT_TEST(setRankOf(set, element) == 9);
+    freeInt(element);
+    ASSERT_TEST(setGetByRank(set, 50) == NULL);
+    int missing = 100;
+    ASSERT_TEST(setRankOf(set, &missing) == 50);
+    ASSERT_TEST(setRankOf(NULL, &missing) == -1);
+    Set copy = setCopy(set);
+    ASSERT_TEST(setGetSize(copy) == 50);
+    ASSERT_TEST(setClear(set) == SET_SUCCESS);
+    ASSERT_TEST(setGetSize(set) == 0);
+    ASSERT_TEST(setGetSize(copy) == 50);
+    setDestroy(set);
+    setDestroy(copy);
+    return true;
+}
+
+bool testSetUnionIntersect() {
+    Set evens = setCreate(copyInt, freeInt, compareInts);
+    Set threes = setCreate(copyInt, freeInt, compareInts);
+    for (int i = 0; i < 60; ++i) {
+        if (i % 2 == 0) {
+            ASSERT_TEST(setAdd(evens, &i) == SET_SUCCESS);
+        }
+        if (i % 3 == 0) {
+            ASSERT_TEST(setAdd(threes, &i) == SET_SUCCESS);
+        }
+    }
+    Set all = setUnion(evens, threes);
+    Set sixes = setIntersect(evens, threes);
+    ASSERT_TEST(all != NULL && sixes != NULL);
+    ASSERT_TEST(setGetSize(all) == 40);
+    ASSERT_TEST(setGetSize(sixes) == 10);
+    for (int i = 0; i < 60; ++i) {
+        ASSERT_TEST(setContains(all, &i) == (i % 2 == 0 || i % 3 == 0));
+        ASSERT_TEST(setContains(sixes, &i) == (i % 6 == 0));
+    }
+    ASSERT_TEST(setGetSize(evens) == 30);
+    ASSERT_TEST(setUnion(evens, NULL) == NULL);
+    // Combining sets in the middle of iterating over them leaves their iterators in place
+    int expected = 0;
+    SET_FOREACH(int *, iterator, threes) {
+        ASSERT_TEST(*iterator == expected);
+        freeInt(iterator);
+        expected += 3;
+        Set united = setUnion(evens, threes);
+        Set intersection = setIntersect(threes, evens);
+        ASSERT_TEST(setGetSize(united) == 40 && setGetSize(intersection) == 10);
+        setDestroy(united);
+        setDestroy(intersection);
+    }
+    ASSERT_TEST(expected == 60);
+    setDestroy(evens);
+    setDestroy(threes);
+    setDestroy(all);
+    setDestroy(sixes);
+    return true;
+}
+
+/*The functions for the tests should be added here*/
+bool (*tests[]) (void) = {
+        testSetAddRemove,
+        testSetIteration,
+        testSetUnionIntersect
+};
+
+/*The names of the test functions should be added here*/
+const char* testNames[] = {
+        "testSetAddRemove",
+        "testSetIteration",
+        "testSetUnionIntersect"
+};
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        for (int test_idx = 0; test_idx < NUMBER_TESTS; test_idx++) {
+            RUN_TEST(tests[test_idx], testNames[test_idx]);
+        }
+        return 0;
+    }
+    if (argc != 2) {
+        fprintf(stdout, "Usage: <your_executable_file_name> <test index>\n");
+        return 0;
+    }
+
+    int test_idx = (int) strtol(argv[1], NULL, 10);
+    if (test_idx < 1 || test_idx > NUMBER_TESTS) {
+        fprintf(stderr, "Invalid test index %d\n", test_idx);
+        return 0;
+    }
+
+    RUN_TEST(tests[test_idx - 1], testNames[test_idx - 1]);
+    return 0;
+}
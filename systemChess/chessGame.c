@@ -1,78 +1,248 @@
+#include <pthread.h>
+#include <string.h>
 #include "headers/chessGame.h"
+#include "../map/headers/cpuFeatures.h"
 
-struct chess_game_t {
-    int game_id;
-    int first_player;
-    int second_player;
-    Winner game_winner;
-    int duration;
+#ifdef HAS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#define GAMES_INITIAL_CAPACITY 4
+#define GAMES_GROWTH_FACTOR 2
+
+struct chess_games_t {
+    int *first_player;
+    int *second_player;
+    Winner *winner;
+    int *duration;
+    int count;
+    int capacity;
 };
 
-ChessGame createChessGame(int id, int first_player, int second_player, Winner winner, int duration){
-    ChessGame game = (ChessGame)malloc(sizeof(struct chess_game_t));
-    if(game == NULL){
-        free(game);
+/** Type of the kernels summing a duration column and finding its largest value */
+typedef void(*durationTotalsFunction)(const int *, int, long *, int *);
+
+static pthread_once_t duration_kernel_once = PTHREAD_ONCE_INIT;
+static durationTotalsFunction durationTotals = NULL;
+
+static bool growColumns(ChessGames games, int capacity);
+static void durationTotalsScalar(const int *durations, int count, long *total, int *longest);
+static void selectDurationKernel();
+
+static void durationTotalsScalar(const int *durations, int count, long *total, int *longest){
+    long sum = 0;
+    int max = 0;
+    for(int i = 0; i < count; i++){
+        sum += durations[i];
+        max = durations[i] > max ? durations[i] : max;
+    }
+    *total = sum;
+    *longest = max;
+}
+
+#ifdef HAS_X86_KERNELS
+__attribute__((target("sse2")))
+static void durationTotalsSse2(const int *durations, int count, long *total, int *longest){
+    __m128i sums = _mm_setzero_si128();
+    __m128i maxima = _mm_setzero_si128();
+    int i = 0;
+    for(; i + 4 <= count; i += 4){
+        __m128i block = _mm_loadu_si128((const __m128i *) (durations + i));
+        __m128i is_greater = _mm_cmpgt_epi32(block, maxima);
+        maxima = _mm_or_si128(_mm_and_si128(is_greater, block), _mm_andnot_si128(is_greater, maxima));
+        // Widens the durations to 64 bits, pairing each with its sign
+        __m128i signs = _mm_srai_epi32(block, 31);
+        sums = _mm_add_epi64(sums, _mm_unpacklo_epi32(block, signs));
+        sums = _mm_add_epi64(sums, _mm_unpackhi_epi32(block, signs));
+    }
+    long long lane_sums[2];
+    int lane_maxima[4];
+    _mm_storeu_si128((__m128i *) lane_sums, sums);
+    _mm_storeu_si128((__m128i *) lane_maxima, maxima);
+    durationTotalsScalar(durations + i, count - i, total, longest);
+    *total += (long) (lane_sums[0] + lane_sums[1]);
+    for(int lane = 0; lane < 4; lane++){
+        *longest = lane_maxima[lane] > *longest ? lane_maxima[lane] : *longest;
+    }
+}
+
+__attribute__((target("avx2")))
+static void durationTotalsAvx2(const int *durations, int count, long *total, int *longest){
+    __m256i sums = _mm256_setzero_si256();
+    __m256i maxima = _mm256_setzero_si256();
+    int i = 0;
+    for(; i + 8 <= count; i += 8){
+        __m256i block = _mm256_loadu_si256((const __m256i *) (durations + i));
+        maxima = _mm256_max_epi32(maxima, block);
+        sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(block)));
+        sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(block, 1)));
+    }
+    long long lane_sums[4];
+    int lane_maxima[8];
+    _mm256_storeu_si256((__m256i *) lane_sums, sums);
+    _mm256_storeu_si256((__m256i *) lane_maxima, maxima);
+    durationTotalsScalar(durations + i, count - i, total, longest);
+    *total += (long) (lane_sums[0] + lane_sums[1] + lane_sums[2] + lane_sums[3]);
+    for(int lane = 0; lane < 8; lane++){
+        *longest = lane_maxima[lane] > *longest ? lane_maxima[lane] : *longest;
+    }
+}
+#endif
+
+/**
+ * Picks the widest duration kernel the CPU supports
+ */
+static void selectDurationKernel(){
+    durationTotals = durationTotalsScalar;
+#ifdef HAS_X86_KERNELS
+    switch(cpuGetVectorLevel()){
+        case CPU_VECTOR_AVX2:
+            durationTotals = durationTotalsAvx2;
+            break;
+        case CPU_VECTOR_SSE2:
+            durationTotals = durationTotalsSse2;
+            break;
+        default:
+            break;
+    }
+#endif
+}
+
+ChessGames createChessGames(){
+    pthread_once(&duration_kernel_once, selectDurationKernel);
+    ChessGames games = (ChessGames)malloc(sizeof(struct chess_games_t));
+    if(games == NULL){
         return NULL;
     }
-    game->game_id = id;
-    game->first_player = first_player;
-    game->second_player = second_player;
-    game->game_winner = winner;
-    game->duration = duration;
-    return game;
+    games->first_player = NULL;
+    games->second_player = NULL;
+    games->winner = NULL;
+    games->duration = NULL;
+    games->count = 0;
+    games->capacity = 0;
+    return games;
 }
 
-ChessGame createEmptyChessGame(){
-    ChessGame game = (ChessGame)malloc(sizeof(struct chess_game_t));
-    if(game == NULL){
-        free(game);
+void freeChessGames(ChessGames games){
+    if(games == NULL){
+        return;
+    }
+    free(games->first_player);
+    free(games->second_player);
+    free(games->winner);
+    free(games->duration);
+    free(games);
+}
+
+ChessGames copyChessGames(ChessGames data){
+    if(data == NULL){
+        return NULL;
+    }
+    ChessGames games = createChessGames();
+    if(games == NULL){
+        return NULL;
+    }
+    if(data->count == 0){
+        return games;
+    }
+    if(!growColumns(games, data->count)){
+        freeChessGames(games);
         return NULL;
     }
-    return game;
+    size_t count = (size_t) data->count;
+    memcpy(games->first_player, data->first_player, sizeof(int) * count);
+    memcpy(games->second_player, data->second_player, sizeof(int) * count);
+    memcpy(games->winner, data->winner, sizeof(Winner) * count);
+    memcpy(games->duration, data->duration, sizeof(int) * count);
+    games->count = data->count;
+    return games;
+}
+
+int addChessGame(ChessGames games, int first_player, int second_player, Winner winner, int duration){
+    if(games->count == games->capacity){
+        int capacity = games->capacity == 0 ? GAMES_INITIAL_CAPACITY : games->capacity * GAMES_GROWTH_FACTOR;
+        if(!growColumns(games, capacity)){
+            return -1;
+        }
+    }
+    int game_id = games->count++;
+    games->first_player[game_id] = first_player;
+    games->second_player[game_id] = second_player;
+    games->winner[game_id] = winner;
+    games->duration[game_id] = duration;
+    return game_id;
+}
+
+int getGamesCount(ChessGames games){
+    return games->count;
 }
 
-int getGameId(ChessGame game){
-    return game->game_id;
+int getFirstPlayerId(ChessGames games, int game_id){
+    return games->first_player[game_id];
 }
 
-int getFirstPlayerId(ChessGame game){
-    return game->first_player;
+int getSecondPlayerId(ChessGames games, int game_id){
+    return games->second_player[game_id];
 }
 
-int getSecondPlayerId(ChessGame game){
-    return game->second_player;
+Winner getGameWinner(ChessGames games, int game_id){
+    return games->winner[game_id];
 }
 
-int getGameWinnerId(ChessGame game){
-    if(game->game_winner == FIRST_PLAYER){
-        return game->first_player;
+int getGameWinnerId(ChessGames games, int game_id){
+    if(games->winner[game_id] == FIRST_PLAYER){
+        return games->first_player[game_id];
     }
-    if(game->game_winner == SECOND_PLAYER){
-        return game->second_player;
+    if(games->winner[game_id] == SECOND_PLAYER){
+        return games->second_player[game_id];
     }
     return DRAW_ID_NOTATION;
 }
 
-int getDuration(ChessGame game){
-    return game->duration;
+int getDuration(ChessGames games, int game_id){
+    return games->duration[game_id];
 }
 
-void setGameWinner(ChessGame game, Winner game_winner){
-    game->game_winner=game_winner;
+void getDurationTotals(ChessGames games, long *total, int *longest){
+    if(games->count == 0){
+        *total = 0;
+        *longest = 0;
+        return;
+    }
+    durationTotals(games->duration, games->count, total, longest);
 }
 
-ChessGame copyGame(ChessGame data) {
-    if (data == NULL) {
-        return NULL;
+void setGameWinner(ChessGames games, int game_id, Winner game_winner){
+    games->winner[game_id] = game_winner;
+}
+
+size_t getGamesMemorySize(ChessGames games){
+    return sizeof(*games) + (size_t) games->capacity * (sizeof(int) * 3 + sizeof(Winner));
+}
+
+// A column that grew before a later one failed keeps its larger size, and the capacity stays the smallest
+static bool growColumns(ChessGames games, int capacity){
+    size_t count = (size_t) capacity;
+    int *first_player = realloc(games->first_player, sizeof(int) * count);
+    if(first_player == NULL){
+        return false;
     }
-    ChessGame game = createEmptyChessGame();
-    if (game == NULL) {
-        return NULL;
+    games->first_player = first_player;
+    int *second_player = realloc(games->second_player, sizeof(int) * count);
+    if(second_player == NULL){
+        return false;
+    }
+    games->second_player = second_player;
+    Winner *winner = realloc(games->winner, sizeof(Winner) * count);
+    if(winner == NULL){
+        return false;
+    }
+    games->winner = winner;
+    int *duration = realloc(games->duration, sizeof(int) * count);
+    if(duration == NULL){
+        return false;
     }
-    game->game_id = data->game_id;
-    game->first_player = data->first_player;
-    game->second_player = data->second_player;
-    game->game_winner = data->game_winner;
-    game->duration = data->duration;
-    return game;
+    games->duration = duration;
+    games->capacity = capacity;
+    return true;
 }
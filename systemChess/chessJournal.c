@@ -0,0 +1,244 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "headers/chessJournal.h"
+#include "../map/headers/hash.h"
+
+/**
+ * Every record is a header followed by payload_length bytes: the values, then the text without its NUL.
+ * payload_checksum is the FNV-1a hash of the payload, and header_checksum the hash of the header taken with a zero
+ * header_checksum. The header is checked on its own first, so its length is trusted only once it is known to be
+ * intact, and a damaged length is not mistaken for a record cut short by a crash.
+ */
+typedef struct {
+    uint32_t payload_length;
+    uint32_t payload_checksum;
+    uint32_t header_checksum;
+    uint8_t type;
+    uint8_t values_count;
+    uint16_t reserved;
+} JournalRecordHeader;
+
+struct chess_journal_t {
+    FILE *file;
+    int sync_interval;
+    int pending_records;
+    bool failed;
+};
+
+/**
+ * valid_length is the offset right after the last record read successfully, and file_size is the size of the file
+ * when the reader opened it. A record is a torn tail if its header is cut short by the end of the file, or if its
+ * header is intact but its payload runs past the end. Any other damaged record is corruption.
+ */
+struct journal_reader_t {
+    FILE *file;
+    char *text;
+    size_t text_capacity;
+    long valid_length;
+    long file_size;
+    JournalState state;
+};
+
+static uint32_t headerChecksum(JournalRecordHeader header);
+static uint32_t payloadChecksum(const int *values, size_t values_size, const char *text, size_t text_length);
+static bool stopReading(JournalReader reader, JournalState state);
+
+ChessJournal journalOpen(const char *path, int sync_interval){
+    ChessJournal journal = malloc(sizeof(*journal));
+    if(journal == NULL){
+        return NULL;
+    }
+    journal->file = fopen(path, "ab");
+    if(journal->file == NULL){
+        free(journal);
+        return NULL;
+    }
+    journal->sync_interval = sync_interval;
+    journal->pending_records = 0;
+    journal->failed = false;
+    return journal;
+}
+
+bool journalAppend(ChessJournal journal, const JournalRecord *record){
+    size_t text_length = record->text == NULL ? 0 : strlen(record->text);
+    size_t values_size = sizeof(int) * (size_t) record->values_count;
+    JournalRecordHeader header = {(uint32_t) (values_size + text_length),
+                                  payloadChecksum(record->values, values_size, record->text, text_length), 0,
+                                  (uint8_t) record->type, (uint8_t) record->values_count, 0};
+    header.header_checksum = headerChecksum(header);
+    if(fwrite(&header, sizeof(header), 1, journal->file) != 1
+       || fwrite(record->values, 1, values_size, journal->file) != values_size
+       || fwrite(record->text == NULL ? "" : record->text, 1, text_length, journal->file) != text_length){
+        journal->failed = true;
+        return false;
+    }
+    journal->pending_records++;
+    if(journal->sync_interval > 0 && journal->pending_records >= journal->sync_interval){
+        return journalSync(journal);
+    }
+    return true;
+}
+
+bool journalSync(ChessJournal journal){
+    if(fflush(journal->file) != 0 || fsync(fileno(journal->file)) != 0){
+        journal->failed = true;
+    }
+    journal->pending_records = 0;
+    bool succeeded = !journal->failed;
+    journal->failed = false;
+    return succeeded;
+}
+
+bool journalTruncate(ChessJournal journal){
+    if(fflush(journal->file) != 0 || ftruncate(fileno(journal->file), 0) != 0){
+        return false;
+    }
+    journal->pending_records = 0;
+    journal->failed = false;
+    return fsync(fileno(journal->file)) == 0;
+}
+
+bool journalClose(ChessJournal journal){
+    if(journal == NULL){
+        return true;
+    }
+    bool succeeded = journalSync(journal);
+    if(fclose(journal->file) != 0){
+        succeeded = false;
+    }
+    free(journal);
+    return succeeded;
+}
+
+JournalReader journalReaderOpen(const char *path){
+    JournalReader reader = malloc(sizeof(*reader));
+    if(reader == NULL){
+        return NULL;
+    }
+    reader->file = fopen(path, "rb");
+    if(reader->file == NULL){
+        free(reader);
+        return NULL;
+    }
+    if(fseek(reader->file, 0, SEEK_END) != 0 || (reader->file_size = ftell(reader->file)) < 0
+       || fseek(reader->file, 0, SEEK_SET) != 0){
+        fclose(reader->file);
+        free(reader);
+        return NULL;
+    }
+    reader->text = NULL;
+    reader->text_capacity = 0;
+    reader->valid_length = 0;
+    reader->state = JOURNAL_INTACT;
+    return reader;
+}
+
+bool journalReadRecord(JournalReader reader, JournalRecord *record){
+    if(reader->state != JOURNAL_INTACT){
+        return false;
+    }
+    JournalRecordHeader header;
+    size_t header_read = fread(&header, 1, sizeof(header), reader->file);
+    if(header_read == 0 && reader->valid_length == reader->file_size){
+        return false;
+    }
+    // A header can only be cut short by the end of the file
+    if(header_read != sizeof(header)){
+        return stopReading(reader, JOURNAL_TORN_TAIL);
+    }
+    size_t values_size = sizeof(int) * header.values_count;
+    size_t record_size = sizeof(header) + header.payload_length;
+    if(headerChecksum(header) != header.header_checksum || header.values_count > JOURNAL_MAX_VALUES
+       || header.payload_length < values_size){
+        return stopReading(reader, JOURNAL_CORRUPT);
+    }
+    // The length is checked against the file before anything is allocated for the payload
+    if((long) record_size > reader->file_size - reader->valid_length){
+        return stopReading(reader, JOURNAL_TORN_TAIL);
+    }
+    size_t text_length = header.payload_length - values_size;
+    if(text_length + 1 > reader->text_capacity){
+        char *text = realloc(reader->text, text_length + 1);
+        if(text == NULL){
+            return stopReading(reader, JOURNAL_OUT_OF_MEMORY);
+        }
+        reader->text = text;
+        reader->text_capacity = text_length + 1;
+    }
+    if(fread(record->values, 1, values_size, reader->file) != values_size
+       || fread(reader->text, 1, text_length, reader->file) != text_length
+       || payloadChecksum(record->values, values_size, reader->text, text_length) != header.payload_checksum){
+        return stopReading(reader, JOURNAL_CORRUPT);
+    }
+    reader->valid_length += (long) record_size;
+    reader->text[text_length] = '\0';
+    record->type = (JournalRecordType) header.type;
+    record->values_count = header.values_count;
+    record->text = reader->text;
+    return true;
+}
+
+JournalState journalReaderState(JournalReader reader){
+    return reader->state;
+}
+
+long journalReaderValidLength(JournalReader reader){
+    return reader->valid_length;
+}
+
+bool journalRepair(const char *path, JournalState *state){
+    *state = JOURNAL_INTACT;
+    JournalReader reader = journalReaderOpen(path);
+    if(reader == NULL){
+        // A journal which does not exist yet has nothing to repair
+        FILE *file = fopen(path, "rb");
+        if(file == NULL){
+            return true;
+        }
+        fclose(file);
+        return false;
+    }
+    JournalRecord record;
+    while(journalReadRecord(reader, &record));
+    *state = reader->state;
+    long valid_length = reader->valid_length;
+    journalReaderClose(reader);
+    if(*state == JOURNAL_TORN_TAIL){
+        return truncate(path, valid_length) == 0;
+    }
+    return *state == JOURNAL_INTACT;
+}
+
+void journalReaderClose(JournalReader reader){
+    if(reader == NULL){
+        return;
+    }
+    fclose(reader->file);
+    free(reader->text);
+    free(reader);
+}
+
+// Hashes a header, taken with a zero header_checksum
+static uint32_t headerChecksum(JournalRecordHeader header){
+    header.header_checksum = 0;
+    return hashFnv1a(FNV_OFFSET_BASIS, &header, sizeof(header));
+}
+
+static uint32_t payloadChecksum(const int *values, size_t values_size, const char *text, size_t text_length){
+    return hashFnv1a(hashFnv1a(FNV_OFFSET_BASIS, values, values_size), text, text_length);
+}
+
+/**
+ * Stops the reading at a record that could not be read
+ * @param reader
+ * @param state - Why the record could not be read
+ * @return false, as no record was read
+ */
+static bool stopReading(JournalReader reader, JournalState state){
+    reader->state = state;
+    return false;
+}
@@ -0,0 +1,297 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include "headers/chessSystem.h"
+
+//Defines
+#define LOAD_BUFFER_SIZE (1 << 16)
+#define LOAD_BATCH_SIZE 1024
+#define TOURNAMENT_RECORD 'T'
+#define GAME_RECORD 'G'
+#define COMMENT_RECORD '#'
+#define FIELD_SEPARATOR ','
+#define DECIMAL_BASE 10
+
+/**
+ * State of a load. Records are parsed in place inside buffer, and consecutive games of the same tournament
+ * are collected in games until they are added together by chessAddGames.
+ * lines[i] is the line number of games[i], for reporting its result.
+ */
+typedef struct {
+    ChessSystem chess;
+    FILE *stream;
+    const ChessLoadHandlers *handlers;
+    char buffer[LOAD_BUFFER_SIZE + 1];
+    size_t start;
+    size_t end;
+    long line_number;
+    long records;
+    int batch_tournament;
+    int batch_size;
+    ChessGameInput games[LOAD_BATCH_SIZE];
+    ChessResult results[LOAD_BATCH_SIZE];
+    long lines[LOAD_BATCH_SIZE];
+} ChessLoader;
+
+static bool readLine(ChessLoader *loader, char **line, bool *too_long);
+static bool parseNumber(char **cursor, int *number);
+static bool parseSeparator(char **cursor);
+static ChessResult loadRecord(ChessLoader *loader, char *line);
+static ChessResult loadTournament(ChessLoader *loader, char *fields);
+static ChessResult loadGame(ChessLoader *loader, char *fields);
+static ChessResult flushGames(ChessLoader *loader);
+static void reportError(ChessLoader *loader, long line_number, ChessResult error);
+static void reportProgress(ChessLoader *loader);
+
+ChessResult chessLoadFromStream(ChessSystem chess, FILE *stream, const ChessLoadHandlers *handlers) {
+    if (chess == NULL || stream == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    ChessLoader *loader = malloc(sizeof(*loader));
+    if (loader == NULL) {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    loader->chess = chess;
+    loader->stream = stream;
+    loader->handlers = handlers;
+    loader->start = 0;
+    loader->end = 0;
+    loader->line_number = 0;
+    loader->records = 0;
+    loader->batch_size = 0;
+
+    ChessResult result = CHESS_SUCCESS;
+    char *line = NULL;
+    bool too_long = false;
+    while (result == CHESS_SUCCESS && readLine(loader, &line, &too_long)) {
+        if (too_long) {
+            loader->records++;
+            reportError(loader, loader->line_number, CHESS_LOAD_FAILURE);
+            continue;
+        }
+        result = loadRecord(loader, line);
+    }
+    if (result == CHESS_SUCCESS) {
+        result = flushGames(loader);
+    }
+    if (result == CHESS_SUCCESS && ferror(stream)) {
+        result = CHESS_LOAD_FAILURE;
+    }
+    reportProgress(loader);
+    free(loader);
+    return result;
+}
+
+ChessResult chessLoadFromFile(ChessSystem chess, const char *path_file, const ChessLoadHandlers *handlers) {
+    if (chess == NULL || path_file == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    FILE *stream = fopen(path_file, "r");
+    if (stream == NULL) {
+        return CHESS_LOAD_FAILURE;
+    }
+    ChessResult result = chessLoadFromStream(chess, stream, handlers);
+    fclose(stream);
+    return result;
+}
+
+/**
+ * Reads the next line of the stream into the buffer, refilling it as needed
+ * @param loader
+ * @param line - the line is stored here, NUL terminated and without its line break
+ * @param too_long - set to true if the line does not fit in the buffer, in which case it was skipped
+ * @return false if the stream ended, true otherwise
+ */
+static bool readLine(ChessLoader *loader, char **line, bool *too_long) {
+    *too_long = false;
+    while (true) {
+        char *line_start = loader->buffer + loader->start;
+        char *line_end = memchr(line_start, '\n', loader->end - loader->start);
+        if (line_end != NULL) {
+            *line_end = '\0';
+            if (line_end > line_start && line_end[-1] == '\r') {
+                line_end[-1] = '\0';
+            }
+            *line = line_start;
+            loader->start = (size_t) (line_end - loader->buffer) + 1;
+            loader->line_number++;
+            return true;
+        }
+        if (loader->start == 0 && loader->end == LOAD_BUFFER_SIZE) {
+            // No line break in a full buffer, so the rest of the line is dropped
+            *too_long = true;
+            loader->end = 0;
+        } else {
+            memmove(loader->buffer, loader->buffer + loader->start, loader->end - loader->start);
+            loader->end -= loader->start;
+            loader->start = 0;
+        }
+        size_t read = fread(loader->buffer + loader->end, 1, LOAD_BUFFER_SIZE - loader->end, loader->stream);
+        loader->end += read;
+        if (read == 0) {
+            if (loader->end == 0 && !*too_long) {
+                return false;
+            }
+            // The last line has no line break
+            loader->buffer[loader->end] = '\0';
+            if (loader->end > 0 && loader->buffer[loader->end - 1] == '\r') {
+                loader->buffer[loader->end - 1] = '\0';
+            }
+            *line = loader->buffer;
+            loader->start = loader->end;
+            loader->line_number++;
+            return true;
+        }
+    }
+}
+
+/**
+ * Parses a decimal number, which may be negative, and advances the cursor past it
+ * @param cursor
+ * @param number - the number is stored here
+ * @return false if there is no number at the cursor or it does not fit in an int, true otherwise
+ */
+static bool parseNumber(char **cursor, int *number) {
+    char *digit = *cursor;
+    bool negative = *digit == '-';
+    if (negative) {
+        digit++;
+    }
+    if (*digit < '0' || *digit > '9') {
+        return false;
+    }
+    long long value = 0;
+    while (*digit >= '0' && *digit <= '9') {
+        value = value * DECIMAL_BASE + (*digit - '0');
+        if (value > (long long) INT_MAX + 1) {
+            return false;
+        }
+        digit++;
+    }
+    value = negative ? -value : value;
+    if (value > INT_MAX || value < INT_MIN) {
+        return false;
+    }
+    *number = (int) value;
+    *cursor = digit;
+    return true;
+}
+
+static bool parseSeparator(char **cursor) {
+    if (**cursor != FIELD_SEPARATOR) {
+        return false;
+    }
+    (*cursor)++;
+    return true;
+}
+
+/**
+ * Loads a single line. Records the chess system rejects are reported, and do not stop the load
+ * @param loader
+ * @param line
+ * @return CHESS_OUT_OF_MEMORY if the load can not go on, CHESS_SUCCESS otherwise
+ */
+static ChessResult loadRecord(ChessLoader *loader, char *line) {
+    if (*line == '\0' || *line == COMMENT_RECORD) {
+        return CHESS_SUCCESS;
+    }
+    loader->records++;
+    char *fields = line + 1;
+    if (!parseSeparator(&fields)) {
+        reportError(loader, loader->line_number, CHESS_LOAD_FAILURE);
+        return CHESS_SUCCESS;
+    }
+    if (*line == TOURNAMENT_RECORD) {
+        return loadTournament(loader, fields);
+    }
+    if (*line == GAME_RECORD) {
+        return loadGame(loader, fields);
+    }
+    reportError(loader, loader->line_number, CHESS_LOAD_FAILURE);
+    return CHESS_SUCCESS;
+}
+
+// T,<tournament id>,<max games per player>,<location>
+static ChessResult loadTournament(ChessLoader *loader, char *fields) {
+    int tournament_id, max_games_per_player;
+    if (!parseNumber(&fields, &tournament_id) || !parseSeparator(&fields)
+        || !parseNumber(&fields, &max_games_per_player) || !parseSeparator(&fields)) {
+        reportError(loader, loader->line_number, CHESS_LOAD_FAILURE);
+        return CHESS_SUCCESS;
+    }
+    // Games read before the tournament can not belong to it
+    ChessResult result = flushGames(loader);
+    if (result != CHESS_SUCCESS) {
+        return result;
+    }
+    result = chessAddTournament(loader->chess, tournament_id, max_games_per_player, fields);
+    if (result == CHESS_OUT_OF_MEMORY) {
+        return result;
+    }
+    if (result != CHESS_SUCCESS) {
+        reportError(loader, loader->line_number, result);
+    }
+    return CHESS_SUCCESS;
+}
+
+// G,<tournament id>,<first player>,<second player>,<winner>,<play time>, the winner being a Winner value
+static ChessResult loadGame(ChessLoader *loader, char *fields) {
+    int tournament_id, winner;
+    ChessGameInput game;
+    if (!parseNumber(&fields, &tournament_id) || !parseSeparator(&fields)
+        || !parseNumber(&fields, &game.first_player) || !parseSeparator(&fields)
+        || !parseNumber(&fields, &game.second_player) || !parseSeparator(&fields)
+        || !parseNumber(&fields, &winner) || !parseSeparator(&fields)
+        || !parseNumber(&fields, &game.play_time) || *fields != '\0'
+        || winner < FIRST_PLAYER || winner > DRAW) {
+        reportError(loader, loader->line_number, CHESS_LOAD_FAILURE);
+        return CHESS_SUCCESS;
+    }
+    game.winner = (Winner) winner;
+    if (loader->batch_size == LOAD_BATCH_SIZE
+        || (loader->batch_size > 0 && loader->batch_tournament != tournament_id)) {
+        ChessResult result = flushGames(loader);
+        if (result != CHESS_SUCCESS) {
+            return result;
+        }
+    }
+    loader->batch_tournament = tournament_id;
+    loader->games[loader->batch_size] = game;
+    loader->lines[loader->batch_size] = loader->line_number;
+    loader->batch_size++;
+    return CHESS_SUCCESS;
+}
+
+/**
+ * Adds the collected games to their tournament and reports the games that were rejected
+ * @param loader
+ * @return CHESS_OUT_OF_MEMORY if the batch could not be added, CHESS_SUCCESS otherwise
+ */
+static ChessResult flushGames(ChessLoader *loader) {
+    if (loader->batch_size == 0) {
+        return CHESS_SUCCESS;
+    }
+    ChessResult result = chessAddGames(loader->chess, loader->batch_tournament, loader->games,
+                                       loader->batch_size, loader->results);
+    for (int i = 0; i < loader->batch_size; i++) {
+        if (loader->results[i] != CHESS_SUCCESS) {
+            reportError(loader, loader->lines[i], loader->results[i]);
+        }
+    }
+    loader->batch_size = 0;
+    reportProgress(loader);
+    return result == CHESS_OUT_OF_MEMORY ? CHESS_OUT_OF_MEMORY : CHESS_SUCCESS;
+}
+
+static void reportError(ChessLoader *loader, long line_number, ChessResult error) {
+    if (loader->handlers != NULL && loader->handlers->on_error != NULL) {
+        loader->handlers->on_error(line_number, error, loader->handlers->context);
+    }
+}
+
+static void reportProgress(ChessLoader *loader) {
+    if (loader->handlers != NULL && loader->handlers->on_progress != NULL) {
+        loader->handlers->on_progress(loader->records, loader->handlers->context);
+    }
+}
@@ -1,17 +1,47 @@
+#include <string.h>
 #include "headers/chessTournament.h"
 
+#define PAIR_SIZE 2
+#define TOURNAMENT_SCORE_WINS_WEIGHT 2
+
+// A player's place in the standings, taken from their statistics when they were added to them
+typedef struct {
+    int score;
+    int losses;
+    int wins;
+    int id;
+} Standing;
+
 struct chess_tournament_t {
-    Map games;
+    ChessGames games;
     Map players;
+    Set played_pairs;
+    Set standings;
+    bool standings_stale;
     int id;
-    const char *tournament_location;
+    char *tournament_location;
     int tournament_winner;
     int players_counter;
     int max_games_per_player;
     bool has_ended;
-    int last_game_id;
+    long total_play_time;
+    int longest_game;
 };
 
+static void orderPlayersPair(int *pair, int first_player, int second_player);
+static SetElement copyPlayersPair(SetElement pair);
+static void freePlayersPair(SetElement pair);
+static int comparePlayersPairs(SetElement first_pair, SetElement second_pair);
+static size_t sizeOfPlayersPair(SetElement pair);
+static char *copyLocation(const char *location);
+static void createStanding(Standing *standing, Player player);
+static bool rebuildStandings(ChessTournament tournament);
+static int findLeaderByScan(ChessTournament tournament);
+static SetElement copyStanding(SetElement standing);
+static void freeStanding(SetElement standing);
+static int compareStandings(SetElement first_standing, SetElement second_standing);
+static size_t sizeOfStanding(SetElement standing);
+
 // creates new empty tournament
 ChessTournament createEmptyTournament(){
     ChessTournament tournament = (ChessTournament) malloc(sizeof(struct chess_tournament_t));
@@ -29,27 +59,52 @@ ChessTournament createChessTournament(int tournament_id, int max_games_per_playe
         freeTournament(tournament);
         return NULL;
     }
+    tournament->played_pairs = setCreate(copyPlayersPair, freePlayersPair, comparePlayersPairs);
+    if(tournament->played_pairs == NULL){
+        free(tournament);
+        return NULL;
+    }
+    tournament->standings = setCreate(copyStanding, freeStanding, compareStandings);
+    if(tournament->standings == NULL){
+        setDestroy(tournament->played_pairs);
+        free(tournament);
+        return NULL;
+    }
+    tournament->tournament_location = copyLocation(tournament_location);
+    if(tournament->tournament_location == NULL){
+        setDestroy(tournament->played_pairs);
+        setDestroy(tournament->standings);
+        free(tournament);
+        return NULL;
+    }
+    tournament->games = createChessGames();
+    if(tournament->games == NULL){
+        setDestroy(tournament->played_pairs);
+        setDestroy(tournament->standings);
+        free(tournament->tournament_location);
+        free(tournament);
+        return NULL;
+    }
+    tournament->players = NULL;
+    tournament->standings_stale = false;
     tournament->id = tournament_id;
-    tournament->tournament_location = tournament_location;
     tournament->tournament_winner = NO_WINNER;
     tournament->max_games_per_player = max_games_per_player;
     tournament->has_ended = false;
-    tournament->last_game_id = 0;
     tournament->players_counter = 0;
+    tournament->total_play_time = 0;
+    tournament->longest_game = 0;
 
     return tournament;
 }
 
-Map getGames(ChessTournament tournament){
+ChessGames getGames(ChessTournament tournament){
     return tournament->games;
 }
 Map getPlayers(ChessTournament tournament){
     return tournament->players;
 }
 
-int getLastGameId(ChessTournament tournament){
-    return tournament->last_game_id++;
-}
 const char *getLocation(ChessTournament tournament){
     return tournament->tournament_location;
 }
@@ -67,10 +122,6 @@ void setHasEnded(ChessTournament tournament, bool hasEnded){
     tournament->has_ended = hasEnded;
 }
 
-void setGamesMap(ChessTournament tournament, Map games){
-    tournament->games = games;
-}
-
 void updatePlayersCounter(ChessTournament tournament){
     tournament->players_counter++;
 }
@@ -87,19 +138,40 @@ int getNumberOfPlayers(ChessTournament tournament){
     return tournament->players_counter;
 }
 
+void addGameDuration(ChessTournament tournament, int duration){
+    tournament->total_play_time += duration;
+    if(duration > tournament->longest_game){
+        tournament->longest_game = duration;
+    }
+}
+
+int getLongestGame(ChessTournament tournament){
+    return tournament->longest_game;
+}
+
+double getAverageGameTime(ChessTournament tournament){
+    int games_count = getGamesCount(tournament->games);
+    if(games_count <= 0){
+        return 0;
+    }
+    return (double) tournament->total_play_time / games_count;
+}
+
 void freeTournament(ChessTournament data) {
     if (data == NULL) {
         return;
     }
     mapDestroy(data->players);
     setPlayersMap(data, NULL);
-    mapDestroy(data->games);
-    setGamesMap(data, NULL);
+    freeChessGames(data->games);
+    setDestroy(data->played_pairs);
+    setDestroy(data->standings);
+    free(data->tournament_location);
     free(data);
     data = NULL;
 }
 
-ChessTournament copyTournament(ChessTournament data, Map game_map, Map players_map) {
+ChessTournament copyTournament(ChessTournament data, Map players_map) {
     if (data == NULL) {
         return NULL;
     }
@@ -109,29 +181,34 @@ ChessTournament copyTournament(ChessTournament data, Map game_map, Map players_m
         return NULL;
     }
     tournament->id = data->id ;
-    tournament->tournament_location = data->tournament_location;
+    tournament->tournament_location = NULL;
     tournament->tournament_winner = data->tournament_winner;
     tournament->max_games_per_player = data->max_games_per_player;
     tournament->has_ended = data->has_ended;
-    tournament->last_game_id = data->last_game_id;
     tournament->players_counter = data->players_counter;
-
-    Map games = data->games;
-    if (games != NULL) {
-        mapDestroy(game_map);
-        tournament->games =  mapCopy(games);
-        if (tournament->games == NULL) {
-            mapDestroy(tournament->games);
-            free(tournament);
-            return NULL;
-        }
-    } else {
-        if(game_map == NULL){
-            freeTournament(tournament);
-            mapDestroy(game_map);
-            return NULL;
-        }
-        tournament->games = game_map;
+    tournament->total_play_time = data->total_play_time;
+    tournament->longest_game = data->longest_game;
+    tournament->played_pairs = setCopy(data->played_pairs);
+    if (tournament->played_pairs == NULL) {
+        mapDestroy(players_map);
+        free(tournament);
+        return NULL;
+    }
+    tournament->standings_stale = data->standings_stale;
+    tournament->standings = setCopy(data->standings);
+    if (tournament->standings == NULL) {
+        setDestroy(tournament->played_pairs);
+        mapDestroy(players_map);
+        free(tournament);
+        return NULL;
+    }
+    tournament->games = copyChessGames(data->games);
+    if (tournament->games == NULL) {
+        setDestroy(tournament->played_pairs);
+        setDestroy(tournament->standings);
+        mapDestroy(players_map);
+        free(tournament);
+        return NULL;
     }
 
     Map players = data->players;
@@ -139,18 +216,222 @@ ChessTournament copyTournament(ChessTournament data, Map game_map, Map players_m
         mapDestroy(players_map);
         tournament->players = mapCopy(players);
         if (tournament->players == NULL) {
-            mapDestroy(getGames(tournament));
             freeTournament(tournament);
             return NULL;
         }
     } else {
         if(players_map == NULL){
             freeTournament(tournament);
-            mapDestroy(game_map);
-            mapDestroy(players_map);
             return NULL;
         }
         tournament->players = players_map;
     }
+    tournament->tournament_location = copyLocation(data->tournament_location);
+    if (tournament->tournament_location == NULL) {
+        freeTournament(tournament);
+        return NULL;
+    }
     return tournament;
 }
+
+void getTournamentState(ChessTournament tournament, TournamentState *state){
+    state->id = tournament->id;
+    state->max_games_per_player = tournament->max_games_per_player;
+    state->winner = tournament->tournament_winner;
+    state->players_counter = tournament->players_counter;
+    state->has_ended = tournament->has_ended;
+}
+
+void restoreTournamentState(ChessTournament tournament, const TournamentState *state){
+    tournament->id = state->id;
+    tournament->max_games_per_player = state->max_games_per_player;
+    tournament->tournament_winner = state->winner;
+    tournament->players_counter = state->players_counter;
+    tournament->has_ended = state->has_ended != 0;
+    tournament->standings_stale = true;
+}
+
+void restoreGameDurations(ChessTournament tournament){
+    getDurationTotals(tournament->games, &tournament->total_play_time, &tournament->longest_game);
+}
+
+Set getPlayedPairs(ChessTournament tournament){
+    return tournament->played_pairs;
+}
+
+size_t getTournamentMemorySize(ChessTournament tournament){
+    return sizeof(*tournament) + strlen(tournament->tournament_location) + 1
+           + setGetMemoryUsage(tournament->played_pairs, sizeOfPlayersPair)
+           + setGetMemoryUsage(tournament->standings, sizeOfStanding);
+}
+
+// The tournament keeps its own copy of the location, so callers may pass a temporary string
+static char *copyLocation(const char *location){
+    char *copy = malloc(strlen(location) + 1);
+    if(copy == NULL){
+        return NULL;
+    }
+    strcpy(copy, location);
+    return copy;
+}
+
+// The pair is stored as {smaller id, larger id}, so the order of the players does not matter
+static void orderPlayersPair(int *pair, int first_player, int second_player){
+    pair[0] = first_player < second_player ? first_player : second_player;
+    pair[1] = first_player < second_player ? second_player : first_player;
+}
+
+bool hasPlayedPair(ChessTournament tournament, int first_player, int second_player){
+    int pair[PAIR_SIZE];
+    orderPlayersPair(pair, first_player, second_player);
+    return setContains(tournament->played_pairs, pair);
+}
+
+bool addPlayedPair(ChessTournament tournament, int first_player, int second_player){
+    int pair[PAIR_SIZE];
+    orderPlayersPair(pair, first_player, second_player);
+    SetResult result = setAdd(tournament->played_pairs, pair);
+    return result == SET_SUCCESS || result == SET_ITEM_ALREADY_EXISTS;
+}
+
+void removePlayedPair(ChessTournament tournament, int first_player, int second_player){
+    int pair[PAIR_SIZE];
+    orderPlayersPair(pair, first_player, second_player);
+    setRemove(tournament->played_pairs, pair);
+}
+
+static SetElement copyPlayersPair(SetElement pair){
+    int *copy = malloc(sizeof(*copy) * PAIR_SIZE);
+    if(copy == NULL){
+        return NULL;
+    }
+    copy[0] = ((int *) pair)[0];
+    copy[1] = ((int *) pair)[1];
+    return copy;
+}
+
+static void freePlayersPair(SetElement pair){
+    free(pair);
+}
+
+static int comparePlayersPairs(SetElement first_pair, SetElement second_pair){
+    int *first = first_pair, *second = second_pair;
+    if(first[0] != second[0]){
+        return first[0] < second[0] ? -1 : 1;
+    }
+    if(first[1] != second[1]){
+        return first[1] < second[1] ? -1 : 1;
+    }
+    return 0;
+}
+
+static size_t sizeOfPlayersPair(SetElement pair){
+    (void) pair;
+    return sizeof(int) * PAIR_SIZE;
+}
+
+static void createStanding(Standing *standing, Player player){
+    standing->score = getNumOfWins(player) * TOURNAMENT_SCORE_WINS_WEIGHT + getNumOfDraws(player);
+    standing->losses = getNumOfLosses(player);
+    standing->wins = getNumOfWins(player);
+    standing->id = getPlayerId(player);
+}
+
+// If the standings can not hold the player, they are rebuilt from the players map when the leader is needed
+void addStanding(ChessTournament tournament, Player player){
+    if(player == NULL || isRemoved(player) || tournament->standings_stale){
+        return;
+    }
+    Standing standing;
+    createStanding(&standing, player);
+    if(setAdd(tournament->standings, &standing) == SET_OUT_OF_MEMORY){
+        tournament->standings_stale = true;
+    }
+}
+
+void removeStanding(ChessTournament tournament, Player player){
+    if(player == NULL){
+        return;
+    }
+    Standing standing;
+    createStanding(&standing, player);
+    setRemove(tournament->standings, &standing);
+}
+
+int getTournamentLeader(ChessTournament tournament){
+    if(tournament->standings_stale && !rebuildStandings(tournament)){
+        return findLeaderByScan(tournament);
+    }
+    if(setGetSize(tournament->standings) == 0){
+        return NO_WINNER;
+    }
+    Standing *leader = setGetFirst(tournament->standings);
+    if(leader == NULL){
+        return findLeaderByScan(tournament);
+    }
+    int leader_id = leader->id;
+    freeStanding(leader);
+    return leader_id;
+}
+
+static bool rebuildStandings(ChessTournament tournament){
+    setClear(tournament->standings);
+    tournament->standings_stale = false;
+    MAP_FOREACH(int *, iterator, tournament->players) {
+        addStanding(tournament, mapGet(tournament->players, iterator));
+        free(iterator);
+    }
+    return !tournament->standings_stale;
+}
+
+static int findLeaderByScan(ChessTournament tournament){
+    Standing leader = {0, 0, 0, NO_WINNER}, current;
+    MAP_FOREACH(int *, iterator, tournament->players) {
+        Player player = mapGet(tournament->players, iterator);
+        free(iterator);
+        if(player == NULL || isRemoved(player)){
+            continue;
+        }
+        createStanding(&current, player);
+        if(leader.id == NO_WINNER || compareStandings(&current, &leader) < 0){
+            leader = current;
+        }
+    }
+    return leader.id;
+}
+
+static SetElement copyStanding(SetElement standing){
+    Standing *copy = malloc(sizeof(*copy));
+    if(copy == NULL){
+        return NULL;
+    }
+    *copy = *(Standing *) standing;
+    return copy;
+}
+
+static void freeStanding(SetElement standing){
+    free(standing);
+}
+
+// The leader comes first: higher score, then fewer losses, then more wins, then lower id
+static int compareStandings(SetElement first_standing, SetElement second_standing){
+    Standing *first = first_standing, *second = second_standing;
+    if(first->score != second->score){
+        return first->score > second->score ? -1 : 1;
+    }
+    if(first->losses != second->losses){
+        return first->losses < second->losses ? -1 : 1;
+    }
+    if(first->wins != second->wins){
+        return first->wins > second->wins ? -1 : 1;
+    }
+    if(first->id != second->id){
+        return first->id < second->id ? -1 : 1;
+    }
+    return 0;
+}
+
+static size_t sizeOfStanding(SetElement standing){
+    (void) standing;
+    return sizeof(Standing);
+}
@@ -1,20 +1,31 @@
 #ifndef EX1_CHESSGAME_H
 #include "chessSystem.h"
 #include <stdlib.h>
+#include <stdbool.h>
 #define EX1_CHESSGAME_H
 
 #define DRAW_ID_NOTATION (-1)
 
-typedef struct chess_game_t *ChessGame;
+// The games of a tournament, stored as parallel columns indexed by the game id.
+// Games are never taken out, so the ids are 0 to the number of games minus one.
+typedef struct chess_games_t *ChessGames;
 
-ChessGame createChessGame(int id, int first_player, int second_player, Winner winner, int duration);
-ChessGame createEmptyChessGame();
-int getFirstPlayerId(ChessGame game);
-int getSecondPlayerId(ChessGame game);
-int getGameWinnerId(ChessGame game);
-int getDuration(ChessGame game);
+ChessGames createChessGames();
+void freeChessGames(ChessGames games);
+ChessGames copyChessGames(ChessGames data);
+// Returns the id of the new game, or -1 if there was a memory allocation failure
+int addChessGame(ChessGames games, int first_player, int second_player, Winner winner, int duration);
+int getGamesCount(ChessGames games);
+int getFirstPlayerId(ChessGames games, int game_id);
+int getSecondPlayerId(ChessGames games, int game_id);
+Winner getGameWinner(ChessGames games, int game_id);
+// The winner's player id, or DRAW_ID_NOTATION for a draw
+int getGameWinnerId(ChessGames games, int game_id);
+int getDuration(ChessGames games, int game_id);
+// The sum of the durations of all games, and the longest duration, or 0 if there are no games
+void getDurationTotals(ChessGames games, long *total, int *longest);
 
-void setGameWinner(ChessGame game, Winner game_winner);
-ChessGame copyGame(ChessGame data);
+void setGameWinner(ChessGames games, int game_id, Winner game_winner);
+size_t getGamesMemorySize(ChessGames games);
 
 #endif //EX1_CHESSGAME_H
@@ -0,0 +1,60 @@
+#ifndef EX1_CHESSJOURNAL_H
+#include <stdbool.h>
+#define EX1_CHESSJOURNAL_H
+
+#define JOURNAL_MAX_VALUES 5
+
+typedef struct chess_journal_t *ChessJournal;
+typedef struct journal_reader_t *JournalReader;
+
+// The mutating calls of the chess system, as recorded in the journal
+typedef enum {
+    JOURNAL_ADD_TOURNAMENT = 1,
+    JOURNAL_ADD_GAME,
+    JOURNAL_REMOVE_PLAYER,
+    JOURNAL_REMOVE_TOURNAMENT,
+    JOURNAL_END_TOURNAMENT
+} JournalRecordType;
+
+// The arguments of a call. text is the location of JOURNAL_ADD_TOURNAMENT, and NULL for the other calls
+typedef struct {
+    JournalRecordType type;
+    int values[JOURNAL_MAX_VALUES];
+    int values_count;
+    const char *text;
+} JournalRecord;
+
+// Records are buffered, and written and synced to the disk together every sync_interval records.
+// If sync_interval is not positive, they are synced only by journalSync and journalClose.
+ChessJournal journalOpen(const char *path, int sync_interval);
+bool journalAppend(ChessJournal journal, const JournalRecord *record);
+// Returns false if any record since the last sync could not be written
+bool journalSync(ChessJournal journal);
+bool journalTruncate(ChessJournal journal);
+bool journalClose(ChessJournal journal);
+
+// How far a journal could be read. A torn tail is what a crash in the middle of a write leaves: a record whose
+// header is cut short by the end of the file, or whose intact header claims more bytes than the file has left.
+// Any other damaged record is corruption.
+typedef enum {
+    JOURNAL_INTACT,
+    JOURNAL_TORN_TAIL,
+    JOURNAL_CORRUPT,
+    JOURNAL_OUT_OF_MEMORY
+} JournalState;
+
+JournalReader journalReaderOpen(const char *path);
+// Returns false at the end of the journal, or at a record that could not be read, in which case the state of
+// the reader tells why. The text of the record is valid until the next read.
+bool journalReadRecord(JournalReader reader, JournalRecord *record);
+JournalState journalReaderState(JournalReader reader);
+// The offset right after the last record read successfully
+long journalReaderValidLength(JournalReader reader);
+void journalReaderClose(JournalReader reader);
+
+// Reads the journal at path and cuts off its torn tail, so records appended to it follow its last complete record.
+// state is set to the state the journal was found in. Returns false if the journal is corrupt, or could not be
+// read or cut. A journal which does not exist is intact.
+bool journalRepair(const char *path, JournalState *state);
+
+#endif //EX1_CHESSJOURNAL_H
@@ -19,6 +19,8 @@ typedef enum {
     CHESS_NO_TOURNAMENTS_ENDED,
     CHESS_NO_GAMES,
     CHESS_SAVE_FAILURE,
+    CHESS_LOAD_FAILURE,
+    CHESS_JOURNAL_TORN,
     CHESS_SUCCESS
 } ChessResult ;
 
@@ -31,9 +33,47 @@ typedef enum {
     DRAW
 } Winner;
 
+/** A game to be added by chessAddGames */
+typedef struct {
+    int first_player;
+    int second_player;
+    Winner winner;
+    int play_time;
+} ChessGameInput;
+
 /** Type for representing a chess system that organizes chess tournaments */
 typedef struct chess_system_t *ChessSystem;
 
+/** Called by chessLoadFromStream with the line number of a record that was not loaded, and the reason */
+typedef void (*ChessLoadErrorHandler)(long line_number, ChessResult error, void* context);
+
+/** Called by chessLoadFromStream with the number of records read so far */
+typedef void (*ChessLoadProgressHandler)(long records, void* context);
+
+/** Callbacks of chessLoadFromStream. Either handler may be NULL, and context is passed to both */
+typedef struct {
+    ChessLoadErrorHandler on_error;
+    ChessLoadProgressHandler on_progress;
+    void* context;
+} ChessLoadHandlers;
+
+/** Bytes held by a single tournament */
+typedef struct {
+    size_t games;       /* the game columns, by their capacity */
+    size_t players;     /* the tournament's player records */
+    size_t total;       /* games, players and the tournament itself */
+} ChessTournamentMemoryStats;
+
+/** Bytes held by a chess system, by kind */
+typedef struct {
+    size_t games;           /* the game columns of all tournaments */
+    size_t tournament_players; /* the player records of all tournaments */
+    size_t tournaments;     /* the tournaments map and the tournaments themselves */
+    size_t players;         /* the system's player table with its player records and the leaderboard */
+    size_t indexes;         /* the indexes of every player's games and tournaments */
+    size_t total;           /* everything above and the system itself */
+} ChessMemoryStats;
+
 /**
  * chessCreate: create an empty chess system.
  *
@@ -98,6 +138,184 @@ ChessResult chessAddTournament (ChessSystem chess, int tournament_id,
 ChessResult chessAddGame(ChessSystem chess, int tournament_id, int first_player,
                          int second_player, Winner winner, int play_time);
 
+/**
+ * chessAddGames: adds a batch of matches to a chess tournament. The games are added in order, each as
+ *                chessAddGame would add it, so a game may conflict with an earlier game of the batch.
+ *                The tournament is looked up once, and the players' levels are updated once per batch.
+ *
+ * @param chess - chess system that contains the tournament. Must be non-NULL.
+ * @param tournament_id - the tournament id. Must be positive.
+ * @param games - the games to add. Must be non-NULL.
+ * @param n - the number of games.
+ * @param per_game_results - the result of adding games[i], as returned by chessAddGame, is stored in
+ *                           per_game_results[i]. Must be non-NULL. If the batch fails as a whole, every
+ *                           game's result is the returned error.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess, games or per_game_results are NULL.
+ *     CHESS_INVALID_ID - if the tournament ID number is invalid.
+ *     CHESS_TOURNAMENT_NOT_EXIST - if the tournament does not exist in the system.
+ *     CHESS_TOURNAMENT_ENDED - if the tournament already ended
+ *     CHESS_OUT_OF_MEMORY - if the batch could not be prepared, in which case no game was added.
+ *     CHESS_SUCCESS - if the games were processed, each with its own result.
+ */
+ChessResult chessAddGames(ChessSystem chess, int tournament_id, const ChessGameInput* games, int n,
+                          ChessResult* per_game_results);
+
+/**
+ * chessLoadFromStream: adds the tournaments and games read from a text stream, one record per line:
+ *                      T,<tournament id>,<max games per player>,<location>
+ *                      G,<tournament id>,<first player>,<second player>,<winner>,<play time>
+ *                      The winner is a Winner value: 0 for FIRST_PLAYER, 1 for SECOND_PLAYER and 2 for DRAW.
+ *                      Empty lines and lines starting with '#' are skipped. Records are loaded in order, and
+ *                      consecutive games of the same tournament are added together by chessAddGames.
+ *                      A record that is malformed, or that chessAddTournament or chessAddGame would reject, is
+ *                      reported to the error handler and skipped. Games are reported when their batch is added,
+ *                      so they may be reported after later lines. The progress handler is called after every
+ *                      batch of games and when the stream ends.
+ *
+ * @param chess - chess system to load into. Must be non-NULL.
+ * @param stream - an open, readable input stream. Must be non-NULL.
+ * @param handlers - the callbacks to report to. May be NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or stream are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed, in which case the records after the failure were not loaded.
+ *     CHESS_LOAD_FAILURE - if an error occurred while reading the stream.
+ *     CHESS_SUCCESS - if the stream was read to its end.
+ */
+ChessResult chessLoadFromStream(ChessSystem chess, FILE* stream, const ChessLoadHandlers* handlers);
+
+/**
+ * chessLoadFromFile: loads the records of a file, as chessLoadFromStream does.
+ *
+ * @param chess - chess system to load into. Must be non-NULL.
+ * @param path_file - the path of the file to load. Must be non-NULL.
+ * @param handlers - the callbacks to report to. May be NULL.
+ * @return
+ *     CHESS_LOAD_FAILURE - if the file could not be opened.
+ *     Otherwise, the result of chessLoadFromStream.
+ */
+ChessResult chessLoadFromFile(ChessSystem chess, const char* path_file, const ChessLoadHandlers* handlers);
+
+/**
+ * chessSaveSnapshot: saves the whole state of a chess system to a binary file, from which
+ *                    chessLoadSnapshot restores it. The file is checksummed and versioned, and is written
+ *                    in the machine's own layout, so it is only meant to be read on the same kind of machine.
+ *                    The snapshot is first written and synced to path_file with ".tmp" appended, and then
+ *                    renamed over path_file, so after a crash path_file holds either the old snapshot or the
+ *                    complete new one.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @param path_file - the path of the file to write. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path_file are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed, in which case nothing was written.
+ *     CHESS_SAVE_FAILURE - if an error occurred while saving, in which case path_file was left as it was,
+ *                          unless only syncing its directory failed.
+ *     CHESS_SUCCESS - if the snapshot was saved successfully.
+ */
+ChessResult chessSaveSnapshot(ChessSystem chess, const char* path_file);
+
+/**
+ * chessLoadSnapshot: creates a chess system from a file written by chessSaveSnapshot.
+ *                    The file is mapped to memory and its records are read in place.
+ *
+ * @param path_file - the path of the snapshot. Must be non-NULL.
+ * @param chess_result - this variable will contain the returned error code.
+ * @return
+ *     The restored chess system, or NULL if it could not be restored. The error code is:
+ *     CHESS_NULL_ARGUMENT - if path_file is NULL.
+ *     CHESS_LOAD_FAILURE - if the file could not be read, or is not a valid snapshot of this version.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SUCCESS - if the chess system was restored successfully.
+ */
+ChessSystem chessLoadSnapshot(const char* path_file, ChessResult* chess_result);
+
+/**
+ * chessOpenJournal: starts appending every successful call that changes the chess system to a journal file,
+ *                   from which chessReplayJournal repeats them. The calls are written and synced to the disk
+ *                   together, every sync_interval calls. A journal that was already open is closed first.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @param path_file - the path of the journal. Calls are appended to it if it exists, after its torn tail,
+ *                    if it has one, is cut off. Must be non-NULL.
+ * @param sync_interval - the number of calls synced together. If it is not positive, the calls are synced
+ *                        only by chessSyncJournal and chessCloseJournal.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path_file are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed while reading the existing journal.
+ *     CHESS_LOAD_FAILURE - if the existing journal is corrupt. Calls appended to it could never be replayed, so it
+ *                          must be replaced, as described by chessReplayJournal.
+ *     CHESS_SAVE_FAILURE - if the journal could not be opened or cut, or the previous journal could not be closed.
+ *     CHESS_SUCCESS - if the journal was opened successfully.
+ */
+ChessResult chessOpenJournal(ChessSystem chess, const char* path_file, int sync_interval);
+
+/**
+ * chessSyncJournal: writes and syncs to the disk the calls journaled since the last sync.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_SAVE_FAILURE - if a call since the last sync could not be written.
+ *     CHESS_SUCCESS - if the journal was synced successfully, or the system has no journal.
+ */
+ChessResult chessSyncJournal(ChessSystem chess);
+
+/**
+ * chessCloseJournal: syncs and closes the journal of the chess system. chessDestroy closes it as well.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_SAVE_FAILURE - if a call since the last sync could not be written.
+ *     CHESS_SUCCESS - if the journal was closed successfully, or the system has no journal.
+ */
+ChessResult chessCloseJournal(ChessSystem chess);
+
+/**
+ * chessReplayJournal: repeats the calls of a journal in the chess system, in their order.
+ *                     The repeated calls are not journaled again. A damaged record ends the replay. It is a
+ *                     torn tail, such as the record being written when the system crashed, if the end of the
+ *                     file cuts it short and its header is intact as far as it was written. Otherwise the
+ *                     journal is corrupt.
+ *
+ *                     After a crash, the system is recovered by:
+ *                     1. chessLoadSnapshot of the last checkpoint's snapshot, or chessCreate if there was none.
+ *                     2. chessReplayJournal of the journal, which repeats every call up to a torn tail.
+ *                     3. chessOpenJournal of the same journal, which cuts the torn tail off, so the calls
+ *                        journaled from now on directly follow the ones replayed.
+ *                     If the journal is corrupt, the calls after the damage are lost. chessOpenJournal refuses
+ *                     the journal, which must be replaced: save a snapshot with chessSaveSnapshot, remove the
+ *                     journal file, and open it again.
+ *
+ * @param chess - a chess system, in the state the journal was opened at. Must be non-NULL.
+ * @param path_file - the path of the journal. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path_file are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed, in which case the calls after the failure were not repeated.
+ *     CHESS_LOAD_FAILURE - if the journal could not be opened, or is corrupt. The calls before the damaged
+ *                          record were repeated.
+ *     CHESS_JOURNAL_TORN - if the journal ends in a torn tail. Every call before it was repeated.
+ *     CHESS_SUCCESS - if the whole journal was repeated.
+ */
+ChessResult chessReplayJournal(ChessSystem chess, const char* path_file);
+
+/**
+ * chessCheckpoint: saves a snapshot of the chess system, and then empties its journal, since the snapshot
+ *                  already holds the journaled calls. Loading the snapshot and replaying the journal
+ *                  restores the system. The journal is only emptied once the snapshot is synced to the disk,
+ *                  so a crash in between leaves a snapshot that the journal replays on top of harmlessly.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @param path_file - the path of the snapshot. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or path_file are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed while saving the snapshot.
+ *     CHESS_SAVE_FAILURE - if the snapshot could not be saved, or the journal could not be emptied.
+ *     CHESS_SUCCESS - if the checkpoint was taken successfully.
+ */
+ChessResult chessCheckpoint(ChessSystem chess, const char* path_file);
+
 /**
  * chessRemoveTournament: removes the tournament and all the games played in it from the chess system
  *                        updates all players statistics (wins, losses, draws, average play time).
@@ -154,6 +372,24 @@ ChessResult chessRemovePlayer(ChessSystem chess, int player_id);
  */
 ChessResult chessEndTournament (ChessSystem chess, int tournament_id);
 
+/**
+ * chessGetTournamentLeader: returns the player currently leading a tournament, by the same rules
+ *                           chessEndTournament uses to choose the winner. Removed players are not ranked.
+ *                           For a tournament that ended, this is its winner.
+ *
+ * @param chess - chess system that contains the tournament. Must be non-NULL.
+ * @param tournament_id - the tournament id. Must be positive.
+ * @param chess_result - this variable will contain the returned error code.
+ * @return
+ *     The leader's id, or 0 if every player of the tournament was removed. The error code is:
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_INVALID_ID - if the tournament ID number is invalid.
+ *     CHESS_TOURNAMENT_NOT_EXIST - if the tournament does not exist in the system.
+ *     CHESS_NO_GAMES - if the tournament does not have any games.
+ *     CHESS_SUCCESS - if the leader was returned successfully.
+ */
+int chessGetTournamentLeader (ChessSystem chess, int tournament_id, ChessResult* chess_result);
+
 /**
  * chessCalculateAveragePlayTime: the function returns the average playing time for a particular player
  *
@@ -181,6 +417,57 @@ double chessCalculateAveragePlayTime (ChessSystem chess, int player_id, ChessRes
  */
 ChessResult chessSavePlayersLevels (ChessSystem chess, FILE* file);
 
+/**
+ * chessSavePlayersLevelsParallel: prints the same bytes as chessSavePlayersLevels, for large numbers of
+ *                                 players. The levels are computed and sorted in chunks on separate threads,
+ *                                 the sorted chunks are merged in parallel, and each chunk's lines are
+ *                                 formatted on its own thread before all of them are written in order.
+ *                                 The threads are started once and reused by every step.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @param file - an open, writable output stream, to which the ratings are printed.
+ * @param threads - the most threads to use. No more threads are used than there are online CPUs or players
+ *                  to print. With a single thread or less, this is chessSavePlayersLevels.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or file are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed, in which case nothing was printed.
+ *     CHESS_SAVE_FAILURE - if an error occurred while saving.
+ *     CHESS_SUCCESS - if the ratings was printed successfully.
+ */
+ChessResult chessSavePlayersLevelsParallel (ChessSystem chess, FILE* file, int threads);
+
+/**
+ * chessGetPlayerRank: returns a player's position in the players' levels, as printed by chessSavePlayersLevels
+ *
+ * @param chess - a chess system that contains the player. Must be non-NULL.
+ * @param player_id - player ID. Must be positive.
+ * @param chess_result - this variable will contain the returned error code.
+ * @return
+ *     The rank of the player, 1 being the highest level, or 0 if the player has no games. The error code is:
+ *     CHESS_NULL_ARGUMENT - if chess is NULL.
+ *     CHESS_INVALID_ID - if the player ID number is invalid.
+ *     CHESS_PLAYER_NOT_EXIST - if the player does not exist in the system.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SUCCESS - if the rank was returned successfully.
+ */
+int chessGetPlayerRank (ChessSystem chess, int player_id, ChessResult* chess_result);
+
+/**
+ * chessGetTopPlayers: stores the ids of the players with the highest levels, in the order
+ *                     chessSavePlayersLevels prints them
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @param k - the number of players requested.
+ * @param player_ids - the ids are stored here. Must be non-NULL and hold at least k ids.
+ * @param chess_result - this variable will contain the returned error code.
+ * @return
+ *     The number of ids stored, which is less than k if fewer players have games. The error code is:
+ *     CHESS_NULL_ARGUMENT - if chess or player_ids are NULL.
+ *     CHESS_OUT_OF_MEMORY - if an allocation failed.
+ *     CHESS_SUCCESS - if the ids were stored successfully.
+ */
+int chessGetTopPlayers (ChessSystem chess, int k, int* player_ids, ChessResult* chess_result);
+
 /**
  * chessSaveTournamentStatistics: prints to the file the statistics for each tournament that ended as
  * explained in the *.pdf
@@ -195,4 +482,32 @@ ChessResult chessSavePlayersLevels (ChessSystem chess, FILE* file);
  */
 ChessResult chessSaveTournamentStatistics (ChessSystem chess, char* path_file);
 
+/**
+ * chessGetMemoryStats: reports the bytes held by a chess system, broken down by kind.
+ *                      Allocator overhead is not counted.
+ *
+ * @param chess - a chess system. Must be non-NULL.
+ * @param stats - the byte counts are stored here. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or stats are NULL.
+ *     CHESS_SUCCESS - if the statistics were stored successfully.
+ */
+ChessResult chessGetMemoryStats (ChessSystem chess, ChessMemoryStats* stats);
+
+/**
+ * chessGetTournamentMemoryStats: reports the bytes held by a single tournament.
+ *                                Allocator overhead is not counted.
+ *
+ * @param chess - a chess system that contains the tournament. Must be non-NULL.
+ * @param tournament_id - the tournament id. Must be positive.
+ * @param stats - the byte counts are stored here. Must be non-NULL.
+ * @return
+ *     CHESS_NULL_ARGUMENT - if chess or stats are NULL.
+ *     CHESS_INVALID_ID - if the tournament ID number is invalid.
+ *     CHESS_TOURNAMENT_NOT_EXIST - if the tournament does not exist in the system.
+ *     CHESS_SUCCESS - if the statistics were stored successfully.
+ */
+ChessResult chessGetTournamentMemoryStats (ChessSystem chess, int tournament_id,
+                                           ChessTournamentMemoryStats* stats);
+
 #endif //HW1_CHESSSYSTEM_H
@@ -1,29 +1,59 @@
 #ifndef EX1_CHESSTOURNAMENT_H
 #include "../../map/headers/map.h"
+#include "../../map/headers/set.h"
+#include "player.h"
+#include "chessGame.h"
 #include <stdlib.h>
 #define EX1_CHESSTOURNAMENT_H
 #define NO_WINNER (-1)
 
 typedef struct chess_tournament_t *ChessTournament;
 
+// The scalar state of a tournament, as saved in snapshots
+typedef struct {
+    int id;
+    int max_games_per_player;
+    int winner;
+    int players_counter;
+    int has_ended;
+} TournamentState;
+
 ChessTournament createChessTournament(int tournament_id, int max_games_per_player, const char *tournament_location);
 ChessTournament createEmptyTournament();
 
-Map getGames(ChessTournament tournament);
+ChessGames getGames(ChessTournament tournament);
 Map getPlayers(ChessTournament tournament);
 const char *getLocation(ChessTournament tournament);
 int getWinnerId(ChessTournament tournament);
 int getMaxGamesPerPlayer(ChessTournament tournament);
 bool hasEnded(ChessTournament tournament);
-int getLastGameId(ChessTournament tournament);
 int getNumberOfPlayers(ChessTournament tournament);
 void updatePlayersCounter(ChessTournament tournament);
+// Games are never taken out of a tournament, so their durations are summed as they are added
+void addGameDuration(ChessTournament tournament, int duration);
+int getLongestGame(ChessTournament tournament);
+double getAverageGameTime(ChessTournament tournament);
 void setHasEnded(ChessTournament tournament, bool hasEnded);
-void setGamesMap(ChessTournament tournament, Map games);
 void setPlayersMap(ChessTournament tournament, Map players);
 void setTournamentWinner(ChessTournament tournament, int winnerId);
 void freeTournament(ChessTournament data) ;
-ChessTournament copyTournament(ChessTournament data, Map games, Map players);
+ChessTournament copyTournament(ChessTournament data, Map players);
+size_t getTournamentMemorySize(ChessTournament tournament);
+void getTournamentState(ChessTournament tournament, TournamentState *state);
+// The standings are rebuilt from the players map when they are next read
+void restoreTournamentState(ChessTournament tournament, const TournamentState *state);
+// Sets the duration statistics from the games, which are restored without going through addGameDuration
+void restoreGameDurations(ChessTournament tournament);
+Set getPlayedPairs(ChessTournament tournament);
+// Pairs of players who have a game together in the tournament, regardless of their order
+bool hasPlayedPair(ChessTournament tournament, int first_player, int second_player);
+bool addPlayedPair(ChessTournament tournament, int first_player, int second_player);
+void removePlayedPair(ChessTournament tournament, int first_player, int second_player);
+// Standings of the tournament's players who were not removed, ordered by the tournament's tie-break rules.
+// A player must be taken out of the standings before their statistics change, and put back after.
+void addStanding(ChessTournament tournament, Player player);
+void removeStanding(ChessTournament tournament, Player player);
+int getTournamentLeader(ChessTournament tournament);
 
 
 #endif //EX1_CHESSTOURNAMENT_H
@@ -53,5 +53,7 @@ void setPlayerLosses(Player player, int losses);
 
 Player copyPlayer(Player data);
 
+size_t getPlayerMemorySize();
+
 
 #endif //EX1_PLAYER_H
@@ -0,0 +1,30 @@
+#ifndef EX1_PLAYERTABLE_H
+#include <stdbool.h>
+#include <stdlib.h>
+#include "player.h"
+#define EX1_PLAYERTABLE_H
+
+// The players of a chess system, indexed directly by their id through a three level radix table:
+// a fixed root of directories, directories of pages, and pages of players. Dense ids share their pages,
+// so a lookup is three array loads, and only the ranges of ids in use are allocated.
+typedef struct player_table_t *PlayerTable;
+
+PlayerTable playerTableCreate();
+void playerTableDestroy(PlayerTable table);
+int playerTableGetSize(PlayerTable table);
+// Returns NULL if there is no player with the id, including for ids that are not positive
+Player playerTableGet(PlayerTable table, int player_id);
+// Creates a player with the id, or returns the existing one. Returns NULL if the id is not positive,
+// or if there was a memory allocation failure
+Player playerTableAdd(PlayerTable table, int player_id);
+// Returns the player with the smallest id greater than player_id, or NULL if there is none
+Player playerTableGetNext(PlayerTable table, int player_id);
+// The bytes held by the table and its players
+size_t playerTableGetMemoryUsage(PlayerTable table);
+
+// Iterates over the players of the table in the order of their ids
+#define PLAYER_TABLE_FOREACH(player, table) \
+    for(Player player = playerTableGetNext(table, 0); player != NULL; \
+        player = playerTableGetNext(table, getPlayerId(player)))
+
+#endif //EX1_PLAYERTABLE_H
@@ -1,45 +1,211 @@
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "headers/chessGame.h"
 #include "headers/chessTournament.h"
 #include "headers/player.h"
+#include "headers/chessJournal.h"
+#include "headers/playerTable.h"
+#include "../map/headers/hash.h"
+#include "../map/headers/multiMap.h"
 
 //Defines
 #define LEVEL_WINS_WEIGHT 6
 #define LEVEL_DRAWS_WEIGHT 2
 #define LEVEL_LOSSES_WEIGHT (-10)
-#define TOURNAMENT_SCORE_WINS_WEIGHT 2
+#define SNAPSHOT_MAGIC 0x53534843u
+#define SNAPSHOT_VERSION 3u
+#define SNAPSHOT_TEMPORARY_SUFFIX ".tmp"
+#define PAIR_SIZE 2
+#define JOURNAL_BATCH_SIZE 1024
+// Longer than any "<id> <level>" line, as a level lies between LEVEL_LOSSES_WEIGHT and LEVEL_WINS_WEIGHT
+#define EXPORT_LINE_SIZE 48
 
 struct chess_system_t {
     Map tournaments;
-    Map players;
+    PlayerTable players;
+    MultiMap player_games;
+    MultiMap player_tournaments;
+    Set leaderboard;
+    bool leaderboard_stale;
+    ChessJournal journal;
 };
 
+/** A game of a player, as listed in the player_games index */
+typedef struct {
+    int tournament_id;
+    int game_id;
+} GameReference;
+
+/** A player's entry in the leaderboard, which holds the players who were not removed and have games */
+typedef struct {
+    double level;
+    int id;
+} LeaderboardEntry;
+
+/**
+ * A slice of a parallel levels export, handled by one thread. Each stage reads and writes only the slice
+ * [begin, end) of its arrays: computing the levels of players into target and sorting them, merging the
+ * sorted runs [begin, middle) and [middle, end) of source into target, or formatting source into text.
+ */
+typedef struct {
+    Player *players;
+    LeaderboardEntry *source;
+    LeaderboardEntry *target;
+    int begin;
+    int middle;
+    int end;
+    char *text;
+    size_t text_length;
+} ExportChunk;
+
+struct export_pool_t;
+
+/** A thread of an export pool, which handles the chunk with the index chunk in every stage */
+typedef struct {
+    struct export_pool_t *pool;
+    int chunk;
+    pthread_t thread;
+} ExportWorker;
+
+/**
+ * The threads of a parallel levels export, started once and reused by all of its stages. The calling thread
+ * handles chunk 0 of every stage, and worker i handles chunk i + 1 if the stage has it. A stage starts by
+ * advancing generation, and ends when none of the workers is running it.
+ */
+typedef struct export_pool_t {
+    pthread_mutex_t lock;
+    pthread_cond_t stage_started;
+    pthread_cond_t stage_finished;
+    void *(*stage)(void *);
+    ExportChunk *chunks;
+    int chunks_number;
+    int generation;
+    int running;
+    bool stopping;
+    ExportWorker *workers;
+    int workers_number;
+} ExportPool;
+
+/**
+ * Snapshots are written in the machine's own layout: the header, the system's player records,
+ * then every tournament with its location, player records, games and played pairs.
+ * The checksum is the FNV-1a hash of the payload_size bytes following the header.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t checksum;
+    uint32_t tournaments_count;
+    uint32_t players_count;
+    uint32_t reserved;
+    uint64_t payload_size;
+} SnapshotHeader;
+
+typedef struct {
+    int id;
+    int wins;
+    int draws;
+    int losses;
+    int play_time;
+    int is_removed;
+} PlayerRecord;
+
+typedef struct {
+    int id;
+    int first_player;
+    int second_player;
+    int winner;
+    int duration;
+} GameRecord;
+
+typedef struct {
+    TournamentState state;
+    int location_length;
+    int players_count;
+    int games_count;
+    int pairs_count;
+} TournamentRecord;
+
+typedef struct {
+    FILE *file;
+    uint32_t checksum;
+    uint64_t size;
+    bool failed;
+} SnapshotWriter;
+
+typedef struct {
+    const unsigned char *cursor;
+    const unsigned char *end;
+} SnapshotReader;
+
 // Static Functions //
 static bool checkValidID(int id);
 static bool checkValidLocation(const char *location);
 static bool checkValidMaxGame(int gameLimit);
 static bool checkValidGameTime(int time);
+static bool checkValidPlayers(int first_player, int second_player);
 static bool checkGameExists(ChessTournament tournament, int first_player, int second_player,
-                            bool was_first_removed, bool was_second_removed, ChessResult *result);
+                            bool was_first_removed, bool was_second_removed);
 static bool checkMaxGamesExceeded(ChessSystem chess, int tournament_id, int first_player, int second_player,
                                   bool ignore_first_player_games, bool ignore_second_player_games);
 bool hasTournamentEnded(ChessSystem chess, ChessResult *result);
 
-void updateGameStatistics(ChessSystem chess, ChessGame game, Map players_map, int player_id);
-Player compareTournamentScores(Player current_player, int *current_highest, Player current_winner);
-void switchPlayers(int *first_id, int *second_id, double *first_score, double *second_score);
-void maxSort(int *ids, double *scores, int size);
-void calculateTournamentStatistics(ChessTournament tournament, double *average_game_time, int *longest_game,
-                                   ChessResult *result);
+void updateGameStatistics(ChessSystem chess, ChessTournament tournament, int game_id, int player_id);
+static size_t getMapMemory(Map map, sizeOfMapDataElements dataSize);
+static void collectTournamentMemoryStats(ChessTournament tournament, ChessTournamentMemoryStats *stats);
+static void writeSnapshotBytes(SnapshotWriter *writer, const void *bytes, size_t size);
+static bool syncParentDirectory(const char *path_file);
+static bool startExportPool(ExportPool *pool, ExportWorker *workers, int workers_number);
+static void stopExportPool(ExportPool *pool);
+static void *runExportWorker(void *worker);
+static void runExportStage(ExportPool *pool, ExportChunk *chunks, int chunks_number, void *(*stage)(void *));
+static void *computeChunkLevels(void *chunk);
+static void *mergeChunkRuns(void *chunk);
+static void *formatChunkLevels(void *chunk);
+static int compareExportEntries(const void *first_entry, const void *second_entry);
+static void writePlayerRecord(SnapshotWriter *writer, Player player);
+static void writePlayerRecords(SnapshotWriter *writer, Map players);
+static void writeTournamentSnapshot(SnapshotWriter *writer, ChessTournament tournament);
+static bool readSnapshotBytes(SnapshotReader *reader, void *target, size_t size);
+static ChessResult verifySnapshot(const unsigned char *snapshot, size_t size, SnapshotHeader *header);
+static bool readPlayerRecord(SnapshotReader *reader, PlayerRecord *record);
+static void applyPlayerRecord(Player player, const PlayerRecord *record);
+static ChessResult restorePlayer(ChessSystem chess, SnapshotReader *reader, int tournament_id, Map players);
+static ChessResult restoreSystemPlayer(SnapshotReader *reader, PlayerTable players);
+static ChessResult restoreTournament(ChessSystem chess, SnapshotReader *reader);
 
 // Chess Functions //
 ChessResult convertMapResultToChessResult(MapResult map_result);
 ChessTournament createTournament(int tournament_id, int max_games_per_player, const char *tournament_location);
 ChessResult chessRemovePlayerEffects(ChessSystem chess, Player player);
-void updatePlayersStatistics(Map players, ChessGame game, int player_id, bool was_removed);
-ChessResult chessAddPlayer(ChessSystem chess, ChessTournament tournament, int player_id);
+void updatePlayersStatistics(Player player_profile, ChessGames games, int game_id, bool was_removed);
+ChessResult chessAddPlayer(ChessSystem chess, ChessTournament tournament, int tournament_id, int player_id);
+ChessResult getOpenTournament(ChessSystem chess, int tournament_id, ChessTournament *tournament);
+Set collectBatchPlayers(const ChessGameInput *games, int n);
+void setLeaderboardPlayers(ChessSystem chess, Set player_ids, bool add);
+ChessResult addGameToTournament(ChessSystem chess, ChessTournament tournament, int tournament_id, int first_player,
+                                int second_player, Winner winner, int play_time, bool update_leaderboard);
+ChessResult indexGame(ChessSystem chess, int tournament_id, int game_id, int first_player, int second_player);
+void unindexGame(ChessSystem chess, int first_player, int second_player);
+void unindexTournament(ChessSystem chess, int tournament_id, Map tournament_players);
+ChessResult registerPlayer(ChessSystem chess, int tournament_id, int player_id);
+void addToLeaderboard(ChessSystem chess, Player player);
+void removeFromLeaderboard(ChessSystem chess, Player player);
+bool refreshLeaderboard(ChessSystem chess);
+double calculatePlayerLevel(Player player);
+void journalCall(ChessSystem chess, JournalRecordType type, const int *values, int values_count, const char *text);
+ChessResult replayJournalRecord(ChessSystem chess, const JournalRecord *record, ChessGameInput *games,
+                                int *games_count, int *games_tournament);
+ChessResult flushJournalGames(ChessSystem chess, ChessGameInput *games, int *games_count, int games_tournament);
 
 
 // mapCreate Functions //
@@ -49,8 +215,18 @@ void freeMapData(MapDataElement data);
 MapDataElement copyMapKey(MapKeyElement key);
 void freeMapDataTournament(MapDataElement data);
 MapDataElement copyMapDataTournament(MapDataElement data);
-MapDataElement copyMapDataGame(MapDataElement data);
 MapDataElement copyMapDataPlayer(MapDataElement data);
+size_t sizeOfMapKey(MapKeyElement key);
+MultiMapValueElement copyGameReference(MultiMapValueElement reference);
+void freeGameReference(MultiMapValueElement reference);
+bool equalGameReferences(MultiMapValueElement first, MultiMapValueElement second);
+bool equalIds(MultiMapValueElement first, MultiMapValueElement second);
+size_t sizeOfMapDataPlayer(MapDataElement data);
+SetElement copyLeaderboardEntry(SetElement entry);
+void freeLeaderboardEntry(SetElement entry);
+int compareLeaderboardEntries(SetElement first_entry, SetElement second_entry);
+size_t sizeOfLeaderboardEntry(SetElement entry);
+size_t sizeOfGameReference(MultiMapValueElement reference);
 
 int compareMapKeys(MapKeyElement key1, MapKeyElement key2) {
     if (key1 == NULL) return -1;
@@ -78,17 +254,75 @@ void freeMapDataTournament(MapDataElement data) {
     freeTournament((ChessTournament) data);
 }
 MapDataElement copyMapDataTournament(MapDataElement data) {
-    Map game_map = mapCreate(copyMapDataGame, copyMapKey, freeMapData, freeMapKey, compareMapKeys);
     Map players_map = mapCreate(copyMapDataPlayer, copyMapKey, freeMapData, freeMapKey,
                                 compareMapKeys);
-    return copyTournament((ChessTournament) data, game_map, players_map);
-}
-MapDataElement copyMapDataGame(MapDataElement data) {
-    return copyGame((ChessGame) data);
+    return copyTournament((ChessTournament) data, players_map);
 }
 MapDataElement copyMapDataPlayer(MapDataElement data) {
     return copyPlayer((Player) data);
 }
+MultiMapValueElement copyGameReference(MultiMapValueElement reference) {
+    GameReference *copy = malloc(sizeof(*copy));
+    if (copy == NULL) {
+        return NULL;
+    }
+    *copy = *(GameReference *) reference;
+    return copy;
+}
+void freeGameReference(MultiMapValueElement reference) {
+    free(reference);
+}
+bool equalGameReferences(MultiMapValueElement first, MultiMapValueElement second) {
+    GameReference *first_reference = first, *second_reference = second;
+    return first_reference->tournament_id == second_reference->tournament_id
+           && first_reference->game_id == second_reference->game_id;
+}
+bool equalIds(MultiMapValueElement first, MultiMapValueElement second) {
+    return *(int *) first == *(int *) second;
+}
+size_t sizeOfMapKey(MapKeyElement key) {
+    (void) key;
+    return sizeof(int);
+}
+size_t sizeOfMapDataPlayer(MapDataElement data) {
+    (void) data;
+    return getPlayerMemorySize();
+}
+
+SetElement copyLeaderboardEntry(SetElement entry) {
+    LeaderboardEntry *copy = malloc(sizeof(*copy));
+    if (copy == NULL) {
+        return NULL;
+    }
+    *copy = *(LeaderboardEntry *) entry;
+    return copy;
+}
+
+void freeLeaderboardEntry(SetElement entry) {
+    free(entry);
+}
+
+// Higher levels come first, and players with the same level are ordered by id
+int compareLeaderboardEntries(SetElement first_entry, SetElement second_entry) {
+    LeaderboardEntry *first = first_entry, *second = second_entry;
+    if (first->level != second->level) {
+        return first->level > second->level ? -1 : 1;
+    }
+    if (first->id != second->id) {
+        return first->id < second->id ? -1 : 1;
+    }
+    return 0;
+}
+
+size_t sizeOfLeaderboardEntry(SetElement entry) {
+    (void) entry;
+    return sizeof(LeaderboardEntry);
+}
+
+size_t sizeOfGameReference(MultiMapValueElement reference) {
+    (void) reference;
+    return sizeof(GameReference);
+}
 
 /**
  * Check if id is valid
@@ -143,6 +377,10 @@ static bool checkValidGameTime(int time) {
     return false;
 }
 
+static bool checkValidPlayers(int first_player, int second_player) {
+    return first_player != second_player && checkValidID(first_player) && checkValidID(second_player);
+}
+
 /**
  * Returns whether or not a game exists in a tournament considering different conditions
  * @param tournament - Chess tournament
@@ -153,26 +391,11 @@ static bool checkValidGameTime(int time) {
  * @return true if game exists, false otherwise
  */
 static bool checkGameExists(ChessTournament tournament, int first_player, int second_player,
-                            bool was_first_removed, bool was_second_removed, ChessResult *result) {
-    *result = CHESS_SUCCESS;
+                            bool was_first_removed, bool was_second_removed) {
     if (was_first_removed || was_second_removed) {
         return false;
     }
-    Map games = getGames(tournament);
-    ChessGame current_game = NULL;
-    MAP_FOREACH(MapKeyElement, iterator, games) {
-        current_game = mapGet(games, iterator);
-        freeMapKey(iterator);
-        if (current_game == NULL) {
-            *result = CHESS_OUT_OF_MEMORY;
-            break;
-        }
-        if (getFirstPlayerId(current_game) == first_player && getSecondPlayerId(current_game) == second_player)
-            return true;
-        if (getFirstPlayerId(current_game) == second_player && getSecondPlayerId(current_game) == first_player)
-            return true;
-    }
-    return false;
+    return hasPlayedPair(tournament, first_player, second_player);
 }
 
 /**
@@ -215,16 +438,45 @@ ChessSystem chessCreate() {
         chessDestroy(chess);
         return NULL;
     }
-    Map players = mapCreate(copyMapDataPlayer, copyMapKey, freeMapData, freeMapKey,
-                            compareMapKeys);
+    PlayerTable players = playerTableCreate();
     if (players == NULL) {
         mapDestroy(tournaments);
-        mapDestroy(players);
-        chessDestroy(chess);
+        free(chess);
+        return NULL;
+    }
+    MultiMap player_games = multiMapCreate(copyMapKey, freeMapKey, compareMapKeys, copyGameReference,
+                                           freeGameReference, equalGameReferences);
+    if (player_games == NULL) {
+        mapDestroy(tournaments);
+        playerTableDestroy(players);
+        free(chess);
+        return NULL;
+    }
+    MultiMap player_tournaments = multiMapCreate(copyMapKey, freeMapKey, compareMapKeys, copyMapKey, freeMapKey,
+                                                 equalIds);
+    if (player_tournaments == NULL) {
+        mapDestroy(tournaments);
+        playerTableDestroy(players);
+        multiMapDestroy(player_games);
+        free(chess);
+        return NULL;
+    }
+    Set leaderboard = setCreate(copyLeaderboardEntry, freeLeaderboardEntry, compareLeaderboardEntries);
+    if (leaderboard == NULL) {
+        mapDestroy(tournaments);
+        playerTableDestroy(players);
+        multiMapDestroy(player_games);
+        multiMapDestroy(player_tournaments);
+        free(chess);
         return NULL;
     }
     chess->tournaments = tournaments;
     chess->players = players;
+    chess->player_games = player_games;
+    chess->player_tournaments = player_tournaments;
+    chess->leaderboard = leaderboard;
+    chess->leaderboard_stale = false;
+    chess->journal = NULL;
     return chess;
 }
 
@@ -232,7 +484,11 @@ void chessDestroy(ChessSystem chess) {
     if (chess == NULL)
         return;
     mapDestroy(chess->tournaments);
-    mapDestroy(chess->players);
+    playerTableDestroy(chess->players);
+    multiMapDestroy(chess->player_games);
+    multiMapDestroy(chess->player_tournaments);
+    setDestroy(chess->leaderboard);
+    journalClose(chess->journal);
     free(chess);
 }
 
@@ -261,19 +517,11 @@ ChessTournament createTournament(int tournament_id, int max_games_per_player, co
     if (tournament == NULL) {
         return NULL;
     }
-    Map games = mapCreate(copyMapDataGame, copyMapKey, freeMapData, freeMapKey, compareMapKeys);
-    if (games == NULL) {
-        mapDestroy(games);
-        freeTournament(tournament);
-        return NULL;
-    }
     Map players = mapCreate(copyMapDataPlayer, copyMapKey, freeMapData, freeMapKey, compareMapKeys);
     if (players == NULL) {
-        mapDestroy(games);
         freeTournament(tournament);
         return NULL;
     }
-    setGamesMap(tournament, games);
     setPlayersMap(tournament, players);
     return tournament;
 }
@@ -315,14 +563,19 @@ ChessResult chessAddTournament(ChessSystem chess, int tournament_id, int max_gam
                                   (MapDataElement) tournament);
     ChessResult chess_result = convertMapResultToChessResult(map_result);
     freeTournament(tournament);
+    if (chess_result == CHESS_SUCCESS) {
+        int values[] = {tournament_id, max_games_per_player};
+        journalCall(chess, JOURNAL_ADD_TOURNAMENT, values, 2, tournament_location);
+    }
     return chess_result;
 }
 
-ChessResult handlePlayerStatus(ChessSystem chess, ChessTournament tournament, int player_id, bool *reset_player) {
+ChessResult handlePlayerStatus(ChessSystem chess, ChessTournament tournament, int tournament_id, int player_id,
+                               bool *reset_player) {
     ChessResult result;
     Player first_player_profile = mapGet(getPlayers(tournament), &player_id);
     if (first_player_profile == NULL) {
-        result = chessAddPlayer(chess, tournament, player_id);
+        result = chessAddPlayer(chess, tournament, tournament_id, player_id);
         if (result != CHESS_SUCCESS) {
             return result;
         }
@@ -340,34 +593,150 @@ ChessResult chessAddGame(ChessSystem chess, int tournament_id, int first_player,
         return CHESS_NULL_ARGUMENT;
     }
 
-    if (!checkValidID(tournament_id) || first_player == second_player || !checkValidID(first_player)
-        || !checkValidID(second_player)) {
+    if (!checkValidID(tournament_id) || !checkValidPlayers(first_player, second_player)) {
         return CHESS_INVALID_ID;
     }
-    ChessTournament tournament = mapGet(chess->tournaments, (MapKeyElement) &tournament_id);
-    if (tournament == NULL) {
+    ChessTournament tournament = NULL;
+    ChessResult result = getOpenTournament(chess, tournament_id, &tournament);
+    if (result != CHESS_SUCCESS) {
+        return result;
+    }
+    return addGameToTournament(chess, tournament, tournament_id, first_player, second_player, winner, play_time,
+                               true);
+}
+
+ChessResult chessAddGames(ChessSystem chess, int tournament_id, const ChessGameInput *games, int n,
+                          ChessResult *per_game_results) {
+    if (chess == NULL || games == NULL || per_game_results == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    ChessTournament tournament = NULL;
+    ChessResult result = checkValidID(tournament_id) ? getOpenTournament(chess, tournament_id, &tournament)
+                                                     : CHESS_INVALID_ID;
+    Set batch_players = NULL;
+    if (result == CHESS_SUCCESS) {
+        batch_players = collectBatchPlayers(games, n);
+        if (batch_players == NULL) {
+            result = CHESS_OUT_OF_MEMORY;
+        }
+    }
+    if (result != CHESS_SUCCESS) {
+        for (int i = 0; i < n; i++) {
+            per_game_results[i] = result;
+        }
+        return result;
+    }
+
+    // Every player of the batch leaves the leaderboard once and comes back once, with their final level
+    setLeaderboardPlayers(chess, batch_players, false);
+    for (int i = 0; i < n; i++) {
+        if (!checkValidPlayers(games[i].first_player, games[i].second_player)) {
+            per_game_results[i] = CHESS_INVALID_ID;
+            continue;
+        }
+        per_game_results[i] = addGameToTournament(chess, tournament, tournament_id, games[i].first_player,
+                                                  games[i].second_player, games[i].winner, games[i].play_time,
+                                                  false);
+    }
+    setLeaderboardPlayers(chess, batch_players, true);
+    setDestroy(batch_players);
+    return CHESS_SUCCESS;
+}
+
+/**
+ * Finds a tournament which games can be added to
+ * @param chess - chess system
+ * @param tournament_id - a valid tournament id
+ * @param tournament - the tournament is stored here
+ * @return CHESS_TOURNAMENT_NOT_EXIST or CHESS_TOURNAMENT_ENDED if games can not be added, CHESS_SUCCESS otherwise
+ */
+ChessResult getOpenTournament(ChessSystem chess, int tournament_id, ChessTournament *tournament) {
+    *tournament = mapGet(chess->tournaments, (MapKeyElement) &tournament_id);
+    if (*tournament == NULL) {
         return CHESS_TOURNAMENT_NOT_EXIST;
     }
-    if (hasEnded(tournament)) {
+    if (hasEnded(*tournament)) {
         return CHESS_TOURNAMENT_ENDED;
     }
+    return CHESS_SUCCESS;
+}
+
+/**
+ * Returns the distinct valid player ids of a batch of games
+ * @param games
+ * @param n - the number of games
+ * @return NULL if there was a memory allocation failure, the set of ids otherwise
+ */
+Set collectBatchPlayers(const ChessGameInput *games, int n) {
+    Set players = setCreate(copyMapKey, freeMapKey, compareMapKeys);
+    if (players == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) {
+        if (!checkValidPlayers(games[i].first_player, games[i].second_player)) {
+            continue;
+        }
+        int first_player = games[i].first_player, second_player = games[i].second_player;
+        if (setAdd(players, &first_player) == SET_OUT_OF_MEMORY
+            || setAdd(players, &second_player) == SET_OUT_OF_MEMORY) {
+            setDestroy(players);
+            return NULL;
+        }
+    }
+    return players;
+}
+
+/**
+ * Takes a group of players out of the leaderboard, or puts them back
+ * @param chess - chess system
+ * @param player_ids - the ids of the players
+ * @param add - true to put the players in the leaderboard, false to take them out
+ */
+void setLeaderboardPlayers(ChessSystem chess, Set player_ids, bool add) {
+    int handled = 0;
+    SET_FOREACH(int *, iterator, player_ids) {
+        Player player = playerTableGet(chess->players, *iterator);
+        if (add) {
+            addToLeaderboard(chess, player);
+        } else {
+            removeFromLeaderboard(chess, player);
+        }
+        freeMapKey(iterator);
+        handled++;
+    }
+    // The iteration stops early if a copy of an id could not be allocated
+    if (handled < setGetSize(player_ids)) {
+        chess->leaderboard_stale = true;
+    }
+}
+
+/**
+ * Validates a game between two valid players of an open tournament and adds it
+ * @param chess - chess system
+ * @param tournament - the tournament of the game
+ * @param tournament_id
+ * @param first_player
+ * @param second_player
+ * @param winner
+ * @param play_time
+ * @param update_leaderboard - false if the caller takes the players out of the leaderboard and puts them back
+ * @return the result of the addition, as documented for chessAddGame
+ */
+ChessResult addGameToTournament(ChessSystem chess, ChessTournament tournament, int tournament_id, int first_player,
+                                int second_player, Winner winner, int play_time, bool update_leaderboard) {
     bool reset_first_player = false, reset_second_player = false;
-    ChessResult result = handlePlayerStatus(chess, tournament, first_player, &reset_first_player);
+    ChessResult result = handlePlayerStatus(chess, tournament, tournament_id, first_player, &reset_first_player);
     if(result != CHESS_SUCCESS){
         return result;
     }
-    result = handlePlayerStatus(chess, tournament, second_player, &reset_second_player);
+    result = handlePlayerStatus(chess, tournament, tournament_id, second_player, &reset_second_player);
     if(result != CHESS_SUCCESS){
         return result;
     }
 
-    if (checkGameExists(tournament, first_player, second_player, reset_first_player, reset_second_player,
-                        &result)) {
+    if (checkGameExists(tournament, first_player, second_player, reset_first_player, reset_second_player)) {
         return CHESS_GAME_ALREADY_EXISTS;
     }
-    if(result != CHESS_SUCCESS){
-        return result;
-    }
     if (!checkValidGameTime(play_time)) {
         return CHESS_INVALID_PLAY_TIME;
     }
@@ -376,30 +745,51 @@ ChessResult chessAddGame(ChessSystem chess, int tournament_id, int first_player,
         return CHESS_EXCEEDED_GAMES;
     }
 
-    int game_id = getLastGameId(tournament);
-    ChessGame game = createChessGame(game_id, first_player, second_player, winner, play_time);
-    if (game == NULL) {
+    if (!addPlayedPair(tournament, first_player, second_player)) {
         return CHESS_OUT_OF_MEMORY;
     }
-    MapResult map_result = mapPut(getGames(tournament), (MapKeyElement) &game_id,
-                                  (MapDataElement) game);
-    result = convertMapResultToChessResult(map_result);
-
-    if (result == CHESS_SUCCESS) {
-        //Update tournament profiles
-        updatePlayersStatistics(getPlayers(tournament), game, first_player, reset_first_player);
-        updatePlayersStatistics(getPlayers(tournament), game, second_player, reset_second_player);
-        //Update system profiles
-        updatePlayersStatistics(chess->players, game, first_player, reset_first_player);
-        updatePlayersStatistics(chess->players, game, second_player, reset_second_player);
-        if(reset_second_player){
-            updatePlayersCounter(tournament);
-        }
-        if(reset_first_player){
-            updatePlayersCounter(tournament);
-        }
+    // The game is indexed under the id it is about to take, and only stored once the index holds it
+    ChessGames games = getGames(tournament);
+    int game_id = getGamesCount(games);
+    result = indexGame(chess, tournament_id, game_id, first_player, second_player);
+    if (result == CHESS_SUCCESS
+        && addChessGame(games, first_player, second_player, winner, play_time) != game_id) {
+        unindexGame(chess, first_player, second_player);
+        result = CHESS_OUT_OF_MEMORY;
+    }
+    if (result != CHESS_SUCCESS) {
+        removePlayedPair(tournament, first_player, second_player);
+        return result;
     }
-    freeMapData(game);
+
+    addGameDuration(tournament, play_time);
+    //Update tournament profiles, taking them out of the standings while they change
+    Map tournament_players = getPlayers(tournament);
+    removeStanding(tournament, mapGet(tournament_players, &first_player));
+    removeStanding(tournament, mapGet(tournament_players, &second_player));
+    updatePlayersStatistics(mapGet(tournament_players, &first_player), games, game_id, reset_first_player);
+    updatePlayersStatistics(mapGet(tournament_players, &second_player), games, game_id, reset_second_player);
+    addStanding(tournament, mapGet(tournament_players, &first_player));
+    addStanding(tournament, mapGet(tournament_players, &second_player));
+    //Update system profiles, taking them out of the leaderboard while they change
+    if (update_leaderboard) {
+        removeFromLeaderboard(chess, playerTableGet(chess->players, first_player));
+        removeFromLeaderboard(chess, playerTableGet(chess->players, second_player));
+    }
+    updatePlayersStatistics(playerTableGet(chess->players, first_player), games, game_id, reset_first_player);
+    updatePlayersStatistics(playerTableGet(chess->players, second_player), games, game_id, reset_second_player);
+    if (update_leaderboard) {
+        addToLeaderboard(chess, playerTableGet(chess->players, first_player));
+        addToLeaderboard(chess, playerTableGet(chess->players, second_player));
+    }
+    if(reset_second_player){
+        updatePlayersCounter(tournament);
+    }
+    if(reset_first_player){
+        updatePlayersCounter(tournament);
+    }
+    int values[] = {tournament_id, first_player, second_player, (int) winner, play_time};
+    journalCall(chess, JOURNAL_ADD_GAME, values, JOURNAL_MAX_VALUES, NULL);
     return result;
 }
 
@@ -417,46 +807,124 @@ ChessResult chessRemoveTournament(ChessSystem chess, int tournament_id) {
     Player system_profile = NULL;
     MAP_FOREACH(MapKeyElement, iterator, players) {
         tournament_profile = mapGet(players, (MapKeyElement) iterator);
-        system_profile = mapGet(chess->players, (MapKeyElement) iterator);
+        system_profile = playerTableGet(chess->players, *(int *) iterator);
         freeMapKey(iterator);
         if (tournament_profile == NULL || system_profile == NULL) {
             return CHESS_OUT_OF_MEMORY;
         }
+        removeFromLeaderboard(chess, system_profile);
         updateDraws(system_profile, -getNumOfDraws(tournament_profile));
         updateLosses(system_profile, -getNumOfLosses(tournament_profile));
         updateWins(system_profile, -getNumOfWins(tournament_profile));
         updatePlayerPlayTime(system_profile, -getPlayerPlayTime(tournament_profile));
+        addToLeaderboard(chess, system_profile);
     }
+    unindexTournament(chess, tournament_id, players);
     mapRemove(chess->tournaments, (MapKeyElement) &tournament_id);
+    journalCall(chess, JOURNAL_REMOVE_TOURNAMENT, &tournament_id, 1, NULL);
+    return CHESS_SUCCESS;
+}
+
+/**
+ * Lists a new game under both of its players in the player_games index
+ * @param chess - chess system
+ * @param tournament_id - the tournament of the game
+ * @param game_id
+ * @param first_player
+ * @param second_player
+ * @return CHESS_OUT_OF_MEMORY if there was a memory allocation failure, in which case nothing was listed,
+ * CHESS_SUCCESS otherwise
+ */
+ChessResult indexGame(ChessSystem chess, int tournament_id, int game_id, int first_player, int second_player) {
+    GameReference reference = {tournament_id, game_id};
+    if (multiMapAppend(chess->player_games, &first_player, &reference) != MULTIMAP_SUCCESS) {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    if (multiMapAppend(chess->player_games, &second_player, &reference) != MULTIMAP_SUCCESS) {
+        multiMapRemoveLastValue(chess->player_games, &first_player);
+        return CHESS_OUT_OF_MEMORY;
+    }
+    return CHESS_SUCCESS;
+}
+
+/**
+ * Undoes indexGame for the game indexed last under both of its players
+ * @param chess - chess system
+ * @param first_player
+ * @param second_player
+ */
+void unindexGame(ChessSystem chess, int first_player, int second_player) {
+    multiMapRemoveLastValue(chess->player_games, &first_player);
+    multiMapRemoveLastValue(chess->player_games, &second_player);
+}
+
+/**
+ * Removes the games of a tournament from the player_games index, and its players from the player_tournaments index
+ * @param chess - chess system
+ * @param tournament_id - the tournament being removed
+ * @param tournament_players - the players of the tournament, the only ones who have games in it
+ */
+void unindexTournament(ChessSystem chess, int tournament_id, Map tournament_players) {
+    MAP_FOREACH(int *, playersIterator, tournament_players) {
+        int games_count = 0;
+        GameReference **games = (GameReference **) multiMapGetValues(chess->player_games, playersIterator,
+                                                                     &games_count);
+        // Removing a game moves the last one into its place, so the list is scanned backwards
+        for (int i = games_count - 1; i >= 0; i--) {
+            if (games[i]->tournament_id == tournament_id) {
+                multiMapRemoveValueAt(chess->player_games, playersIterator, i);
+            }
+        }
+        multiMapRemoveValue(chess->player_tournaments, playersIterator, &tournament_id);
+        freeMapKey(playersIterator);
+    }
+}
+
+/**
+ * Lists a tournament under a player who got a profile in it, in the player_tournaments index
+ * @param chess - chess system
+ * @param tournament_id
+ * @param player_id
+ * @return CHESS_OUT_OF_MEMORY if there was a memory allocation failure, CHESS_SUCCESS otherwise
+ */
+ChessResult registerPlayer(ChessSystem chess, int tournament_id, int player_id) {
+    if (multiMapAppend(chess->player_tournaments, &player_id, &tournament_id) != MULTIMAP_SUCCESS) {
+        return CHESS_OUT_OF_MEMORY;
+    }
     return CHESS_SUCCESS;
 }
 
 /**
  * Updates game result if one of the play was flagged as removed
  * @param chess - chess system
- * @param game - game to update
+ * @param tournament - the tournament of the game
+ * @param game_id - game to update
  * @param player_id - removed player id
  */
-void updateGameStatistics(ChessSystem chess, ChessGame game, Map tournament_players, int removed_player) {
-    int first_player_id = getFirstPlayerId(game);
-    int second_player_id = getSecondPlayerId(game);
-    int winner_id = getGameWinnerId(game);
+void updateGameStatistics(ChessSystem chess, ChessTournament tournament, int game_id, int removed_player) {
+    Map tournament_players = getPlayers(tournament);
+    ChessGames games = getGames(tournament);
+    int first_player_id = getFirstPlayerId(games, game_id);
+    int second_player_id = getSecondPlayerId(games, game_id);
+    int winner_id = getGameWinnerId(games, game_id);
     Player system_profile = NULL, tournament_profile = NULL;
     if(first_player_id == removed_player){
         if(winner_id == second_player_id){
             return;
         }
-        system_profile = mapGet(chess->players, &second_player_id);
+        system_profile = playerTableGet(chess->players, second_player_id);
         tournament_profile = mapGet(tournament_players, &second_player_id);
-        setGameWinner(game, SECOND_PLAYER);
+        setGameWinner(games, game_id, SECOND_PLAYER);
     } else {
         if(winner_id == first_player_id){
             return;
         }
-        system_profile = mapGet(chess->players, &first_player_id);
+        system_profile = playerTableGet(chess->players, first_player_id);
         tournament_profile = mapGet(tournament_players, &first_player_id);
-        setGameWinner(game, FIRST_PLAYER);
+        setGameWinner(games, game_id, FIRST_PLAYER);
     }
+    removeStanding(tournament, tournament_profile);
+    removeFromLeaderboard(chess, system_profile);
     updateWins(system_profile, 1);
     updateWins(tournament_profile, 1);
     if(winner_id == DRAW_ID_NOTATION) {
@@ -466,6 +934,8 @@ void updateGameStatistics(ChessSystem chess, ChessGame game, Map tournament_play
         updateLosses(system_profile, -1);
         updateLosses(tournament_profile, -1);
     }
+    addStanding(tournament, tournament_profile);
+    addToLeaderboard(chess, system_profile);
 }
 
 /**
@@ -477,37 +947,33 @@ void updateGameStatistics(ChessSystem chess, ChessGame game, Map tournament_play
  */
 ChessResult chessRemovePlayerEffects(ChessSystem chess, Player player) {
     int player_id = getPlayerId(player);
-    ChessGame current_game = NULL;
+    ChessGames current_games = NULL;
     ChessTournament current_tournament = NULL;
-    Map games = NULL, players = NULL;
     Player tournament_profile = NULL;
-    MAP_FOREACH(MapKeyElement, iterator, chess->tournaments) {
-        current_tournament = mapGet(chess->tournaments, (MapKeyElement) iterator);
-        freeMapKey(iterator);
-        if (current_tournament == NULL) {
-            return CHESS_OUT_OF_MEMORY;
-        }
-        players = getPlayers(current_tournament);
-        tournament_profile = mapGet(players, &player_id);
+    // Only the tournaments the player has a profile in are visited, not every tournament of the system
+    int tournaments_count = 0;
+    int **tournament_ids = (int **) multiMapGetValues(chess->player_tournaments, &player_id, &tournaments_count);
+    for (int i = 0; i < tournaments_count; i++) {
+        current_tournament = mapGet(chess->tournaments, tournament_ids[i]);
+        tournament_profile = current_tournament == NULL ? NULL : mapGet(getPlayers(current_tournament), &player_id);
         if (tournament_profile != NULL) {
+            removeStanding(current_tournament, tournament_profile);
             setIsRemoved(tournament_profile, true);
         }
-        if(hasEnded(current_tournament)){
-           continue;
-        }
-        games = getGames(current_tournament);
-        MAP_FOREACH(MapKeyElement, gamesIterator, games) {
-            current_game = mapGet(games, gamesIterator);
-            freeMapKey(gamesIterator);
-            if (current_game == NULL) {
-                return CHESS_OUT_OF_MEMORY;
-            }
-            if(getFirstPlayerId(current_game) != player_id && getSecondPlayerId(current_game) != player_id){
-                continue;
-            }
-
-            updateGameStatistics(chess, current_game, players, player_id);
+    }
+    int games_count = 0;
+    GameReference **games = (GameReference **) multiMapGetValues(chess->player_games, &player_id, &games_count);
+    for (int i = 0; i < games_count; i++) {
+        current_tournament = mapGet(chess->tournaments, &games[i]->tournament_id);
+        if (current_tournament == NULL || hasEnded(current_tournament)) {
+            continue;
         }
+        current_games = getGames(current_tournament);
+        int game_id = games[i]->game_id;
+        // Games of a removed player no longer block a new game between the same players
+        removePlayedPair(current_tournament, getFirstPlayerId(current_games, game_id),
+                         getSecondPlayerId(current_games, game_id));
+        updateGameStatistics(chess, current_tournament, game_id, player_id);
     }
     return CHESS_SUCCESS;
 }
@@ -517,36 +983,33 @@ ChessResult chessRemovePlayer(ChessSystem chess, int player_id) {
         return CHESS_NULL_ARGUMENT;
     if (!checkValidID(player_id))
         return CHESS_INVALID_ID;
-    if (!mapContains(chess->players, (MapKeyElement) &player_id)) {
+    Player player = playerTableGet(chess->players, player_id);
+    if (player == NULL || isRemoved(player)) {
         return CHESS_PLAYER_NOT_EXIST;
     }
-    Player player = mapGet(chess->players, (MapKeyElement) &player_id);
-    ChessResult result = CHESS_SUCCESS;
-    if (player != NULL) {
-        if (isRemoved(player)) {
-            return CHESS_PLAYER_NOT_EXIST;
-        }
-        setIsRemoved(player, true);
-        // Update the player's tournaments profiles and the game he participated
-        result = chessRemovePlayerEffects(chess, player);
+    removeFromLeaderboard(chess, player);
+    setIsRemoved(player, true);
+    // Update the player's tournaments profiles and the games they participated in
+    ChessResult result = chessRemovePlayerEffects(chess, player);
+    if (result == CHESS_SUCCESS) {
+        journalCall(chess, JOURNAL_REMOVE_PLAYER, &player_id, 1, NULL);
     }
     return result;
 }
 
 /**
  * Update time, scores and status of players with the addition of a new game
- * @param players - Map containing the two players, could either be a tournament map or a system map
- * @param game - The game that was added
- * @param player_id
+ * @param player_profile - The player's profile, could either be a tournament profile or a system profile
+ * @param games - The games of the tournament
+ * @param game_id - The game that was added
  * @param was_removed - If true, we need to reset both his removal status the amount of games and time played
  */
-void updatePlayersStatistics(Map players, ChessGame game, int player_id, bool was_removed) {
-    Player player_profile = mapGet(players, (MapKeyElement) &player_id);
+void updatePlayersStatistics(Player player_profile, ChessGames games, int game_id, bool was_removed) {
     if(was_removed){
         resetRemovedPlayerStatistics(player_profile);
     }
-    int winner_id = getGameWinnerId(game);
-    if (winner_id == player_id) {
+    int winner_id = getGameWinnerId(games, game_id);
+    if (winner_id == getPlayerId(player_profile)) {
         updateWins(player_profile, 1);
     } else {
         if (winner_id == DRAW_ID_NOTATION){
@@ -558,32 +1021,39 @@ void updatePlayersStatistics(Map players, ChessGame game, int player_id, bool wa
     if (isRemoved(player_profile)) {
         setIsRemoved(player_profile, false);
     }
-    updatePlayerPlayTime(player_profile, getDuration(game));
+    updatePlayerPlayTime(player_profile, getDuration(games, game_id));
 }
 
 /**
- * Create new player and put it in the system and tournament maps
+ * Create new player and put it in the system and tournament maps, listing the tournament under the player
+ * in the player_tournaments index
  * @param chess - chess system
  * @param tournament
+ * @param tournament_id
  * @param player_id
  * @return CHESS_OUT_OF_MEMORY if there was a memory allocation failure, CHESS_SUCCESS otherwise
  */
-ChessResult chessAddPlayer(ChessSystem chess, ChessTournament tournament, int player_id) {
+ChessResult chessAddPlayer(ChessSystem chess, ChessTournament tournament, int tournament_id, int player_id) {
     ChessResult result;
     Player player = playerCreatePlayer(player_id);
     if (player == NULL) {
         return CHESS_OUT_OF_MEMORY;
     }
-    if (!mapContains(chess->players, &player_id)) {
-        result = convertMapResultToChessResult(mapPut(chess->players, (MapKeyElement) &player_id,
-                                                      (MapDataElement) player));
-        if (result == CHESS_OUT_OF_MEMORY) {
-            freeMapData(player);
-            return result;
-        }
+    if (playerTableAdd(chess->players, player_id) == NULL) {
+        freeMapData(player);
+        return CHESS_OUT_OF_MEMORY;
     }
     result = convertMapResultToChessResult(mapPut(getPlayers(tournament), (MapKeyElement) &player_id,
                                                   (MapDataElement) player));
+    if (result == CHESS_SUCCESS) {
+        result = registerPlayer(chess, tournament_id, player_id);
+        if (result != CHESS_SUCCESS) {
+            mapRemove(getPlayers(tournament), &player_id);
+        }
+    }
+    if (result == CHESS_SUCCESS) {
+        addStanding(tournament, mapGet(getPlayers(tournament), &player_id));
+    }
     updatePlayersCounter(tournament);
     freeMapData(player);
     return result;
@@ -604,53 +1074,36 @@ ChessResult chessEndTournament(ChessSystem chess, int tournament_id) {
         return CHESS_TOURNAMENT_ENDED;
     }
 
-    if (mapGetSize(getGames(tournament)) == 0) {
+    if (getGamesCount(getGames(tournament)) == 0) {
         return CHESS_NO_GAMES;
     }
     setHasEnded(tournament, true);
-    Map players = getPlayers(tournament);
-    Player current_player;
-    Player current_winner = NULL;
-    int highest_score = -1;
-    MAP_FOREACH(MapKeyElement, playersIterator, players) {
-        current_player = mapGet(players, (MapKeyElement) playersIterator);
-        freeMapKey(playersIterator);
-        if (current_player == NULL || isRemoved(current_player)) {
-            continue;
-        }
-        current_winner = compareTournamentScores(current_player, &highest_score, current_winner);
-    }
-    if (current_winner != NULL) {
-        setTournamentWinner(tournament, getPlayerId(current_winner));
-    }
+    setTournamentWinner(tournament, getTournamentLeader(tournament));
+    journalCall(chess, JOURNAL_END_TOURNAMENT, &tournament_id, 1, NULL);
     return CHESS_SUCCESS;
 }
 
-/**
- * Decides if a player's rank in the tournament is higher than a given current best according to several criteria
- * If it is the case, change the values accordingly.
- * @param current_player - Player who's rank we check
- * @param current_highest - Current best tournament score
- * @param current_winner  - Player we compare to
- */
-Player compareTournamentScores(Player current_player, int *current_highest, Player current_winner) {
-    int current_score = (getNumOfWins(current_player)) * TOURNAMENT_SCORE_WINS_WEIGHT + getNumOfDraws(current_player);
-    if (current_score > *current_highest) {
-        *current_highest = current_score;
-        return current_player;
+int chessGetTournamentLeader(ChessSystem chess, int tournament_id, ChessResult *chess_result) {
+    if (chess == NULL) {
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return 0;
     }
-    if (current_score == *current_highest) {
-        if (getNumOfLosses(current_player) < getNumOfLosses(current_winner)) {
-            return current_player;
-        }
-        if (getNumOfLosses(current_player) == getNumOfLosses(current_winner)) {
-            if (getPlayerId(current_player) < getPlayerId(current_winner)
-                || getNumOfWins(current_player) > getNumOfWins(current_winner)) {
-                return current_player;
-            }
-        }
+    if (!checkValidID(tournament_id)) {
+        *chess_result = CHESS_INVALID_ID;
+        return 0;
+    }
+    ChessTournament tournament = mapGet(chess->tournaments, (MapKeyElement) &tournament_id);
+    if (tournament == NULL) {
+        *chess_result = CHESS_TOURNAMENT_NOT_EXIST;
+        return 0;
+    }
+    if (getGamesCount(getGames(tournament)) == 0) {
+        *chess_result = CHESS_NO_GAMES;
+        return 0;
     }
-    return current_winner;
+    int leader_id = hasEnded(tournament) ? getWinnerId(tournament) : getTournamentLeader(tournament);
+    *chess_result = CHESS_SUCCESS;
+    return leader_id == NO_WINNER ? 0 : leader_id;
 }
 
 double chessCalculateAveragePlayTime(ChessSystem chess, int player_id, ChessResult *chess_result) {
@@ -662,15 +1115,11 @@ double chessCalculateAveragePlayTime(ChessSystem chess, int player_id, ChessResu
         *chess_result = CHESS_INVALID_ID;
         return 0;
     }
-    Player player = mapGet(chess->players, &player_id);
-    if (!mapContains(chess->players, (MapKeyElement) &player_id) || (player != NULL && isRemoved(player))) {
+    Player player = playerTableGet(chess->players, player_id);
+    if (player == NULL || isRemoved(player)) {
         *chess_result = CHESS_PLAYER_NOT_EXIST;
         return 0;
     }
-    if (player == NULL) {
-        *chess_result = CHESS_OUT_OF_MEMORY;
-        return 0;
-    }
     double games_played = getNumOfGames(player);
     double total_time = getPlayerPlayTime(player);
     double average_time=0;
@@ -694,95 +1143,377 @@ ChessResult chessSavePlayersLevels(ChessSystem chess, FILE *file) {
     if (chess == NULL || file == NULL) {
         return CHESS_NULL_ARGUMENT;
     }
-
-    Map players = chess->players;
-    Player current_player = NULL;
-
-    int *ids = malloc(sizeof(int) * (unsigned int) mapGetSize(players));
-    double *scores = malloc(sizeof(double) * (unsigned int) mapGetSize(players));
-    if (ids == NULL || scores == NULL) {
-        free(ids);
-        free(scores);
+    if (!refreshLeaderboard(chess)) {
         return CHESS_OUT_OF_MEMORY;
     }
-    int index = 0;
-    double level;
-
-    // For every index, put the id of current_player in ids[index] and his score in scores[index]
-    MAP_FOREACH(MapKeyElement, playerIterator, players) {
-        current_player = mapGet(players, playerIterator);
-        freeMapKey(playerIterator);
-        if (current_player == NULL){
-            return CHESS_OUT_OF_MEMORY;
+    int printed = 0;
+    SET_FOREACH(LeaderboardEntry *, entry, chess->leaderboard) {
+        int print_result = fprintf(file, "%d %.2f\n", entry->id, entry->level);
+        freeLeaderboardEntry(entry);
+        if (print_result < 0) {
+            return CHESS_SAVE_FAILURE;
         }
-        if (isRemoved(current_player) || getNumOfGames(current_player) == 0) {
-            continue;
+        printed++;
+    }
+    // The iteration stops early if a copy of an entry could not be allocated
+    if (printed < setGetSize(chess->leaderboard)) {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    return CHESS_SUCCESS;
+}
+
+ChessResult chessSavePlayersLevelsParallel(ChessSystem chess, FILE *file, int threads) {
+    if (chess == NULL || file == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    // Threads beyond the online CPUs would only take turns on them
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus > 0 && threads > cpus) {
+        threads = (int) cpus;
+    }
+    // On a single thread, printing the leaderboard, which is already sorted, is cheaper
+    if (threads <= 1) {
+        return chessSavePlayersLevels(chess, file);
+    }
+    size_t capacity = (size_t) playerTableGetSize(chess->players) + 1;
+    Player *players = malloc(sizeof(*players) * capacity);
+    LeaderboardEntry *entries = malloc(sizeof(*entries) * capacity);
+    LeaderboardEntry *merged = malloc(sizeof(*merged) * capacity);
+    int chunks_number = threads;
+    ExportChunk *chunks = malloc(sizeof(*chunks) * (size_t) chunks_number);
+    ExportWorker *workers = malloc(sizeof(*workers) * (size_t) (chunks_number - 1));
+    if (players == NULL || entries == NULL || merged == NULL || chunks == NULL || workers == NULL) {
+        free(players);
+        free(entries);
+        free(merged);
+        free(chunks);
+        free(workers);
+        return CHESS_OUT_OF_MEMORY;
+    }
+    // The same players as in the leaderboard
+    int players_count = 0;
+    PLAYER_TABLE_FOREACH(player, chess->players) {
+        if (!isRemoved(player) && getNumOfGames(player) > 0) {
+            players[players_count++] = player;
         }
-        level = calculatePlayerLevel(current_player);
-        ids[index] = getPlayerId(current_player);
-        scores[index] = level;
-        index++;
     }
+    if (chunks_number > players_count) {
+        chunks_number = players_count > 0 ? players_count : 1;
+    }
+    ExportPool pool;
+    if (!startExportPool(&pool, workers, chunks_number - 1)) {
+        free(players);
+        free(entries);
+        free(merged);
+        free(chunks);
+        free(workers);
+        return CHESS_OUT_OF_MEMORY;
+    }
+    for (int i = 0; i < chunks_number; i++) {
+        chunks[i].players = players;
+        chunks[i].target = entries;
+        chunks[i].begin = (int) ((long) players_count * i / chunks_number);
+        chunks[i].end = (int) ((long) players_count * (i + 1) / chunks_number);
+    }
+    runExportStage(&pool, chunks, chunks_number, computeChunkLevels);
 
-    // If the array isn't fully initialized, mark the first uninitialized id in (-1) for the maxSort function
-    if (index < mapGetSize(players) - 1) {
-        ids[index] = -1;
+    // Every round merges adjacent pairs of sorted runs, until a single run is left
+    for (int runs = chunks_number; runs > 1; runs = (runs + 1) / 2) {
+        for (int i = 0; i < (runs + 1) / 2; i++) {
+            int begin = chunks[2 * i].begin;
+            int middle = chunks[2 * i].end;
+            int end = 2 * i + 1 < runs ? chunks[2 * i + 1].end : middle;
+            chunks[i].source = entries;
+            chunks[i].target = merged;
+            chunks[i].begin = begin;
+            chunks[i].middle = middle;
+            chunks[i].end = end;
+        }
+        runExportStage(&pool, chunks, (runs + 1) / 2, mergeChunkRuns);
+        LeaderboardEntry *sorted = merged;
+        merged = entries;
+        entries = sorted;
     }
-    maxSort(ids, scores, index);
 
-    for (int i = 0; i < index; i++) {
-        if(fprintf(file, "%d %.2f\n", ids[i], scores[i]) < 0){
-            free(ids);
-            free(scores);
-            return CHESS_SAVE_FAILURE;
+    for (int i = 0; i < chunks_number; i++) {
+        chunks[i].source = entries;
+        chunks[i].begin = (int) ((long) players_count * i / chunks_number);
+        chunks[i].end = (int) ((long) players_count * (i + 1) / chunks_number);
+    }
+    runExportStage(&pool, chunks, chunks_number, formatChunkLevels);
+    stopExportPool(&pool);
+    ChessResult result = CHESS_SUCCESS;
+    for (int i = 0; i < chunks_number; i++) {
+        if (chunks[i].text == NULL) {
+            result = CHESS_OUT_OF_MEMORY;
         }
     }
-    free(ids);
-    free(scores);
-    return CHESS_SUCCESS;
+    for (int i = 0; i < chunks_number; i++) {
+        if (result == CHESS_SUCCESS
+            && fwrite(chunks[i].text, 1, chunks[i].text_length, file) != chunks[i].text_length) {
+            result = CHESS_SAVE_FAILURE;
+        }
+        free(chunks[i].text);
+    }
+    free(players);
+    free(entries);
+    free(merged);
+    free(chunks);
+    free(workers);
+    return result;
 }
 
 /**
- * Sorts the ids and scores both datasets so that the order aligns with the demand of chessSavePlayerLevels.
- * ids and scores are aligned at the beginning, so for every index i scores[i] is the score of player identified with
- * ids[i].
- * If ids isn't a fully initialized array, the value in the first uninitialized value will be (-1) to mark the end
- * @param ids - Players ids
- * @param scores - Players scores
- * @param size - Total players we sort for (may be lower than size of ids)
+ * Starts the workers of an export pool. Workers which can not be started are left out, and their chunks are
+ * handled by the calling thread.
+ * @param pool - the pool to initialize
+ * @param workers - room for workers_number workers
+ * @param workers_number
+ * @return false if the lock or conditions of the pool could not be initialized, true otherwise
  */
-void maxSort(int *ids, double *scores, int size) {
-    int sorted = 0;
-    while (sorted < size && ids[sorted] != -1) {
-        for (int i = 0; i < size - sorted - 1 && ids[i + 1] != -1; i++) {
-            if (scores[i] < scores[i + 1]) {
-                switchPlayers(&ids[i], &ids[i + 1], &scores[i], &scores[i + 1]);
-                continue;
-            }
-            if (scores[i] == scores[i + 1] && ids[i] > ids[i + 1]) {
-                switchPlayers(&ids[i], &ids[i + 1], &scores[i], &scores[i + 1]);
-                continue;
-            }
+static bool startExportPool(ExportPool *pool, ExportWorker *workers, int workers_number) {
+    if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+        return false;
+    }
+    if (pthread_cond_init(&pool->stage_started, NULL) != 0) {
+        pthread_mutex_destroy(&pool->lock);
+        return false;
+    }
+    if (pthread_cond_init(&pool->stage_finished, NULL) != 0) {
+        pthread_cond_destroy(&pool->stage_started);
+        pthread_mutex_destroy(&pool->lock);
+        return false;
+    }
+    pool->stage = NULL;
+    pool->chunks = NULL;
+    pool->chunks_number = 0;
+    pool->generation = 0;
+    pool->running = 0;
+    pool->stopping = false;
+    pool->workers = workers;
+    pool->workers_number = 0;
+    while (pool->workers_number < workers_number) {
+        ExportWorker *worker = &workers[pool->workers_number];
+        worker->pool = pool;
+        worker->chunk = pool->workers_number + 1;
+        if (pthread_create(&worker->thread, NULL, runExportWorker, worker) != 0) {
+            break;
+        }
+        pool->workers_number++;
+    }
+    return true;
+}
+
+static void stopExportPool(ExportPool *pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->stage_started);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->workers_number; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    pthread_cond_destroy(&pool->stage_finished);
+    pthread_cond_destroy(&pool->stage_started);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+// Runs the worker's chunk of every stage of its pool, until the pool stops
+static void *runExportWorker(void *worker) {
+    ExportWorker *self = worker;
+    ExportPool *pool = self->pool;
+    int generation = 0;
+    pthread_mutex_lock(&pool->lock);
+    while (true) {
+        while (!pool->stopping && pool->generation == generation) {
+            pthread_cond_wait(&pool->stage_started, &pool->lock);
+        }
+        if (pool->stopping) {
+            break;
+        }
+        generation = pool->generation;
+        if (self->chunk < pool->chunks_number) {
+            void *(*stage)(void *) = pool->stage;
+            ExportChunk *chunk = &pool->chunks[self->chunk];
+            pthread_mutex_unlock(&pool->lock);
+            stage(chunk);
+            pthread_mutex_lock(&pool->lock);
+        }
+        if (--pool->running == 0) {
+            pthread_cond_signal(&pool->stage_finished);
         }
-        sorted++;
     }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
 }
 
 /**
- * Preform a sudden, unexpected and humours reversal that none could have seen coming
- * @param first_id - id of the player with lower score
- * @param second_id - id of the player to switch with
- * @param first_score - first score
- * @param second_score - second score
+ * Runs a stage of the levels export on every chunk, on the threads of the pool.
+ * The first chunk is handled by the calling thread, as is any chunk without a worker.
+ * @param pool
+ * @param chunks
+ * @param chunks_number
+ * @param stage
  */
-void switchPlayers(int *first_id, int *second_id, double *first_score, double *second_score) {
-    int dummy_id = *first_id;
-    *first_id = *second_id;
-    *second_id = dummy_id;
+static void runExportStage(ExportPool *pool, ExportChunk *chunks, int chunks_number, void *(*stage)(void *)) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stage = stage;
+    pool->chunks = chunks;
+    pool->chunks_number = chunks_number;
+    pool->generation++;
+    pool->running = pool->workers_number;
+    pthread_cond_broadcast(&pool->stage_started);
+    pthread_mutex_unlock(&pool->lock);
+
+    stage(&chunks[0]);
+    for (int i = pool->workers_number + 1; i < chunks_number; i++) {
+        stage(&chunks[i]);
+    }
 
-    double dummy_score = *first_score;
-    *first_score = *second_score;
-    *second_score = dummy_score;
+    pthread_mutex_lock(&pool->lock);
+    while (pool->running > 0) {
+        pthread_cond_wait(&pool->stage_finished, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void *computeChunkLevels(void *chunk) {
+    ExportChunk *slice = chunk;
+    for (int i = slice->begin; i < slice->end; i++) {
+        slice->target[i].level = calculatePlayerLevel(slice->players[i]);
+        slice->target[i].id = getPlayerId(slice->players[i]);
+    }
+    qsort(slice->target + slice->begin, (size_t) (slice->end - slice->begin), sizeof(LeaderboardEntry),
+          compareExportEntries);
+    return NULL;
+}
+
+static void *mergeChunkRuns(void *chunk) {
+    ExportChunk *slice = chunk;
+    int left = slice->begin, right = slice->middle;
+    for (int i = slice->begin; i < slice->end; i++) {
+        if (right == slice->end || (left < slice->middle
+                                    && compareExportEntries(&slice->source[left], &slice->source[right]) <= 0)) {
+            slice->target[i] = slice->source[left++];
+        } else {
+            slice->target[i] = slice->source[right++];
+        }
+    }
+    return NULL;
+}
+
+// Formats the lines of the slice as chessSavePlayersLevels prints them. text is NULL if it could not be allocated
+static void *formatChunkLevels(void *chunk) {
+    ExportChunk *slice = chunk;
+    size_t capacity = (size_t) (slice->end - slice->begin) * EXPORT_LINE_SIZE + 1;
+    slice->text = malloc(capacity);
+    slice->text_length = 0;
+    for (int i = slice->begin; slice->text != NULL && i < slice->end; i++) {
+        int length = snprintf(slice->text + slice->text_length, capacity - slice->text_length, "%d %.2f\n",
+                              slice->source[i].id, slice->source[i].level);
+        slice->text_length += (size_t) length;
+    }
+    return NULL;
+}
+
+static int compareExportEntries(const void *first_entry, const void *second_entry) {
+    return compareLeaderboardEntries((SetElement) first_entry, (SetElement) second_entry);
+}
+
+int chessGetPlayerRank(ChessSystem chess, int player_id, ChessResult *chess_result) {
+    if (chess == NULL) {
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return 0;
+    }
+    if (!checkValidID(player_id)) {
+        *chess_result = CHESS_INVALID_ID;
+        return 0;
+    }
+    Player player = playerTableGet(chess->players, player_id);
+    if (player == NULL || isRemoved(player)) {
+        *chess_result = CHESS_PLAYER_NOT_EXIST;
+        return 0;
+    }
+    if (!refreshLeaderboard(chess)) {
+        *chess_result = CHESS_OUT_OF_MEMORY;
+        return 0;
+    }
+    *chess_result = CHESS_SUCCESS;
+    if (getNumOfGames(player) == 0) {
+        return 0;
+    }
+    LeaderboardEntry entry = {calculatePlayerLevel(player), player_id};
+    return setRankOf(chess->leaderboard, &entry) + 1;
+}
+
+int chessGetTopPlayers(ChessSystem chess, int k, int *player_ids, ChessResult *chess_result) {
+    if (chess == NULL || player_ids == NULL) {
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return 0;
+    }
+    if (!refreshLeaderboard(chess)) {
+        *chess_result = CHESS_OUT_OF_MEMORY;
+        return 0;
+    }
+    int count = 0;
+    *chess_result = CHESS_SUCCESS;
+    SET_FOREACH(LeaderboardEntry *, entry, chess->leaderboard) {
+        if (count >= k) {
+            freeLeaderboardEntry(entry);
+            break;
+        }
+        player_ids[count++] = entry->id;
+        freeLeaderboardEntry(entry);
+    }
+    if (count < k && count < setGetSize(chess->leaderboard)) {
+        *chess_result = CHESS_OUT_OF_MEMORY;
+    }
+    return count;
+}
+
+/**
+ * Puts a player in the leaderboard by their current level, unless they were removed or have no games
+ * If the leaderboard can not hold them, it is rebuilt from the player table before it is read next
+ * @param chess - chess system
+ * @param player - a system profile
+ */
+void addToLeaderboard(ChessSystem chess, Player player) {
+    if (player == NULL || isRemoved(player) || getNumOfGames(player) == 0 || chess->leaderboard_stale) {
+        return;
+    }
+    LeaderboardEntry entry = {calculatePlayerLevel(player), getPlayerId(player)};
+    if (setAdd(chess->leaderboard, &entry) == SET_OUT_OF_MEMORY) {
+        chess->leaderboard_stale = true;
+    }
+}
+
+/**
+ * Takes a player out of the leaderboard. Must be called before their statistics change
+ * @param chess - chess system
+ * @param player - a system profile
+ */
+void removeFromLeaderboard(ChessSystem chess, Player player) {
+    if (player == NULL || isRemoved(player) || getNumOfGames(player) == 0) {
+        return;
+    }
+    LeaderboardEntry entry = {calculatePlayerLevel(player), getPlayerId(player)};
+    setRemove(chess->leaderboard, &entry);
+}
+
+/**
+ * Rebuilds the leaderboard if an earlier update of it ran out of memory
+ * @param chess - chess system
+ * @return false if the leaderboard could not be rebuilt, true otherwise
+ */
+bool refreshLeaderboard(ChessSystem chess) {
+    if (!chess->leaderboard_stale) {
+        return true;
+    }
+    setClear(chess->leaderboard);
+    chess->leaderboard_stale = false;
+    PLAYER_TABLE_FOREACH(player, chess->players) {
+        addToLeaderboard(chess, player);
+    }
+    return !chess->leaderboard_stale;
 }
 
 ChessResult chessSaveTournamentStatistics(ChessSystem chess, char *path_file) {
@@ -791,8 +1522,6 @@ ChessResult chessSaveTournamentStatistics(ChessSystem chess, char *path_file) {
     }
 
     FILE *tournament_statistics = fopen((const char *) path_file, "w");
-    double average_game_time;
-    int longest_game;
     ChessResult result;
     if(tournament_statistics == NULL){
         fclose(tournament_statistics);
@@ -821,18 +1550,10 @@ ChessResult chessSaveTournamentStatistics(ChessSystem chess, char *path_file) {
         if (!hasEnded(current_tournament)) {
             continue;
         }
-        average_game_time = 0;
-        longest_game = 0;
-        if (mapGetSize(getGames(current_tournament)) != 0) {
-            calculateTournamentStatistics(current_tournament, &average_game_time, &longest_game, &result);
-            if(result != CHESS_SUCCESS){
-                fclose(tournament_statistics);
-                return CHESS_OUT_OF_MEMORY;
-            }
-        }
         print_result = fprintf(tournament_statistics, "%d\n%d\n%.2f\n%s\n%d\n%d\n",
-                               getWinnerId(current_tournament), longest_game, average_game_time, getLocation(current_tournament),
-                               mapGetSize(getGames(current_tournament)), getNumberOfPlayers(current_tournament));
+                               getWinnerId(current_tournament), getLongestGame(current_tournament),
+                               getAverageGameTime(current_tournament), getLocation(current_tournament),
+                               getGamesCount(getGames(current_tournament)), getNumberOfPlayers(current_tournament));
         if(print_result < 0){
             fclose(tournament_statistics);
             return CHESS_SAVE_FAILURE;
@@ -864,32 +1585,578 @@ bool hasTournamentEnded(ChessSystem chess, ChessResult *result) {
     return false;
 }
 
+ChessResult chessGetMemoryStats(ChessSystem chess, ChessMemoryStats *stats) {
+    if (chess == NULL || stats == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    stats->games = 0;
+    stats->tournament_players = 0;
+    stats->tournaments = getMapMemory(chess->tournaments, NULL);
+    MAP_FOREACH(MapKeyElement, tournamentsIterator, chess->tournaments) {
+        ChessTournament tournament = mapGet(chess->tournaments, tournamentsIterator);
+        freeMapKey(tournamentsIterator);
+        ChessTournamentMemoryStats tournament_stats;
+        collectTournamentMemoryStats(tournament, &tournament_stats);
+        stats->games += tournament_stats.games;
+        stats->tournament_players += tournament_stats.players;
+        stats->tournaments += getTournamentMemorySize(tournament);
+    }
+    stats->players = playerTableGetMemoryUsage(chess->players);
+    stats->players += setGetMemoryUsage(chess->leaderboard, sizeOfLeaderboardEntry);
+    stats->indexes = multiMapGetMemoryUsage(chess->player_games, sizeOfMapKey, sizeOfGameReference);
+    stats->indexes += multiMapGetMemoryUsage(chess->player_tournaments, sizeOfMapKey, sizeOfMapKey);
+    stats->total = sizeof(*chess) + stats->games + stats->tournament_players + stats->tournaments + stats->players
+                   + stats->indexes;
+    return CHESS_SUCCESS;
+}
+
+ChessResult chessGetTournamentMemoryStats(ChessSystem chess, int tournament_id, ChessTournamentMemoryStats *stats) {
+    if (chess == NULL || stats == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    if (!checkValidID(tournament_id)) {
+        return CHESS_INVALID_ID;
+    }
+    ChessTournament tournament = mapGet(chess->tournaments, &tournament_id);
+    if (tournament == NULL) {
+        return CHESS_TOURNAMENT_NOT_EXIST;
+    }
+    collectTournamentMemoryStats(tournament, stats);
+    return CHESS_SUCCESS;
+}
+
 /**
- * Calculate time related statistics for a given tournament
- * @param tournament - The tournament we calculate the statistics for
- * @param average_game_time - The average game duration will be inserted here
- * @param longest_game - The longest game duration will be inserted here
+ * Sums the bytes held by a map keyed by ids
+ * @param map
+ * @param dataSize - Returns the bytes used by a data element, NULL if the data elements are counted elsewhere
+ * @return The bytes of the map's structure, keys and data elements
  */
-void calculateTournamentStatistics(ChessTournament tournament, double *average_game_time, int *longest_game,
-                                   ChessResult *result) {
-    Map games = getGames(tournament);
-    ChessGame current_game = NULL;
-    *result = CHESS_SUCCESS;
-    int total_games = 0;
-    MAP_FOREACH(MapKeyElement, gamesIterator, games) {
-        current_game = mapGet(games, gamesIterator);
-        freeMapKey(gamesIterator);
-        if (current_game == NULL) {
-            *result = CHESS_OUT_OF_MEMORY;
-            break;
+static size_t getMapMemory(Map map, sizeOfMapDataElements dataSize) {
+    MapMemoryUsage usage;
+    if (mapGetMemoryUsage(map, sizeOfMapKey, dataSize, &usage) != MAP_SUCCESS) {
+        return 0;
+    }
+    return usage.structure + usage.keys + usage.values;
+}
+
+static void collectTournamentMemoryStats(ChessTournament tournament, ChessTournamentMemoryStats *stats) {
+    stats->games = getGamesMemorySize(getGames(tournament));
+    stats->players = getMapMemory(getPlayers(tournament), sizeOfMapDataPlayer);
+    stats->total = getTournamentMemorySize(tournament) + stats->games + stats->players;
+}
+
+ChessResult chessSaveSnapshot(ChessSystem chess, const char *path_file) {
+    if (chess == NULL || path_file == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    // The snapshot is written aside and renamed over the old one once it is on the disk, so a crash leaves
+    // either the old snapshot or the new one, never a partial one
+    size_t path_length = strlen(path_file);
+    char *temporary_path = malloc(path_length + sizeof(SNAPSHOT_TEMPORARY_SUFFIX));
+    if (temporary_path == NULL) {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    memcpy(temporary_path, path_file, path_length);
+    memcpy(temporary_path + path_length, SNAPSHOT_TEMPORARY_SUFFIX, sizeof(SNAPSHOT_TEMPORARY_SUFFIX));
+    FILE *file = fopen(temporary_path, "wb");
+    if (file == NULL) {
+        free(temporary_path);
+        return CHESS_SAVE_FAILURE;
+    }
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.tournaments_count = (uint32_t) mapGetSize(chess->tournaments);
+    header.players_count = (uint32_t) playerTableGetSize(chess->players);
+    SnapshotWriter writer = {file, FNV_OFFSET_BASIS, 0, false};
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        writer.failed = true;
+    }
+
+    PLAYER_TABLE_FOREACH(player, chess->players) {
+        writePlayerRecord(&writer, player);
+    }
+    uint32_t tournaments_written = 0;
+    MAP_FOREACH(MapKeyElement, tournamentsIterator, chess->tournaments) {
+        writeTournamentSnapshot(&writer, mapGet(chess->tournaments, tournamentsIterator));
+        freeMapKey(tournamentsIterator);
+        tournaments_written++;
+    }
+    // The iteration stops early if a copy of a key could not be allocated
+    if (tournaments_written != header.tournaments_count) {
+        writer.failed = true;
+    }
+
+    header.checksum = writer.checksum;
+    header.payload_size = writer.size;
+    if (!writer.failed && (fseek(file, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, file) != 1
+                           || fflush(file) != 0 || fsync(fileno(file)) != 0)) {
+        writer.failed = true;
+    }
+    if (fclose(file) != 0) {
+        writer.failed = true;
+    }
+    if (!writer.failed && rename(temporary_path, path_file) != 0) {
+        writer.failed = true;
+    }
+    if (writer.failed) {
+        remove(temporary_path);
+    }
+    free(temporary_path);
+    // The rename itself is only durable once the directory holding the snapshot is synced
+    if (!writer.failed && !syncParentDirectory(path_file)) {
+        writer.failed = true;
+    }
+    return writer.failed ? CHESS_SAVE_FAILURE : CHESS_SUCCESS;
+}
+
+/**
+ * Syncs to the disk the directory holding a file, so a file created or renamed in it stays after a crash
+ * @param path_file
+ * @return false if the directory could not be opened or synced, true otherwise
+ */
+static bool syncParentDirectory(const char *path_file) {
+    const char *separator = strrchr(path_file, '/');
+    char *directory = NULL;
+    if (separator == NULL) {
+        directory = malloc(sizeof("."));
+        if (directory != NULL) {
+            strcpy(directory, ".");
         }
-        if (getDuration(current_game) > *longest_game) {
-            *longest_game = getDuration(current_game);
+    } else {
+        // The parent of a file right under the root is the root itself
+        size_t length = separator == path_file ? 1 : (size_t) (separator - path_file);
+        directory = malloc(length + 1);
+        if (directory != NULL) {
+            memcpy(directory, path_file, length);
+            directory[length] = '\0';
         }
-        *average_game_time += getDuration(current_game);
-        total_games++;
     }
-    if(total_games > 0){
-        *average_game_time /= total_games;
+    if (directory == NULL) {
+        return false;
+    }
+    int descriptor = open(directory, O_RDONLY);
+    free(directory);
+    if (descriptor < 0) {
+        return false;
+    }
+    bool synced = fsync(descriptor) == 0;
+    return close(descriptor) == 0 && synced;
+}
+
+ChessSystem chessLoadSnapshot(const char *path_file, ChessResult *chess_result) {
+    if (path_file == NULL) {
+        *chess_result = CHESS_NULL_ARGUMENT;
+        return NULL;
+    }
+    int descriptor = open(path_file, O_RDONLY);
+    if (descriptor < 0) {
+        *chess_result = CHESS_LOAD_FAILURE;
+        return NULL;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size < (off_t) sizeof(SnapshotHeader)) {
+        close(descriptor);
+        *chess_result = CHESS_LOAD_FAILURE;
+        return NULL;
+    }
+    size_t size = (size_t) status.st_size;
+    void *snapshot = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (snapshot == MAP_FAILED) {
+        *chess_result = CHESS_LOAD_FAILURE;
+        return NULL;
+    }
+
+    SnapshotHeader header;
+    ChessSystem chess = NULL;
+    ChessResult result = verifySnapshot(snapshot, size, &header);
+    if (result == CHESS_SUCCESS) {
+        chess = chessCreate();
+        result = chess == NULL ? CHESS_OUT_OF_MEMORY : CHESS_SUCCESS;
+    }
+    SnapshotReader reader = {(const unsigned char *) snapshot + sizeof(header), (const unsigned char *) snapshot + size};
+    for (uint32_t i = 0; result == CHESS_SUCCESS && i < header.players_count; i++) {
+        result = restoreSystemPlayer(&reader, chess->players);
+    }
+    for (uint32_t i = 0; result == CHESS_SUCCESS && i < header.tournaments_count; i++) {
+        result = restoreTournament(chess, &reader);
+    }
+    munmap(snapshot, size);
+    if (result != CHESS_SUCCESS) {
+        chessDestroy(chess);
+        *chess_result = result;
+        return NULL;
+    }
+    // The leaderboard is built from the players when it is first read
+    chess->leaderboard_stale = true;
+    *chess_result = CHESS_SUCCESS;
+    return chess;
+}
+
+static void writeSnapshotBytes(SnapshotWriter *writer, const void *bytes, size_t size) {
+    if (writer->failed || size == 0) {
+        return;
+    }
+    if (fwrite(bytes, size, 1, writer->file) != 1) {
+        writer->failed = true;
+        return;
+    }
+    writer->checksum = hashFnv1a(writer->checksum, bytes, size);
+    writer->size += size;
+}
+
+static void writePlayerRecord(SnapshotWriter *writer, Player player) {
+    PlayerRecord record = {getPlayerId(player), getNumOfWins(player), getNumOfDraws(player),
+                           getNumOfLosses(player), getPlayerPlayTime(player), isRemoved(player)};
+    writeSnapshotBytes(writer, &record, sizeof(record));
+}
+
+static void writePlayerRecords(SnapshotWriter *writer, Map players) {
+    int written = 0;
+    MAP_FOREACH(MapKeyElement, playersIterator, players) {
+        writePlayerRecord(writer, mapGet(players, playersIterator));
+        freeMapKey(playersIterator);
+        written++;
+    }
+    if (written != mapGetSize(players)) {
+        writer->failed = true;
+    }
+}
+
+static void writeTournamentSnapshot(SnapshotWriter *writer, ChessTournament tournament) {
+    TournamentRecord record;
+    memset(&record, 0, sizeof(record));
+    getTournamentState(tournament, &record.state);
+    record.location_length = (int) strlen(getLocation(tournament)) + 1;
+    record.players_count = mapGetSize(getPlayers(tournament));
+    record.games_count = getGamesCount(getGames(tournament));
+    record.pairs_count = setGetSize(getPlayedPairs(tournament));
+    writeSnapshotBytes(writer, &record, sizeof(record));
+    writeSnapshotBytes(writer, getLocation(tournament), (size_t) record.location_length);
+    writePlayerRecords(writer, getPlayers(tournament));
+
+    ChessGames games = getGames(tournament);
+    for (int game_id = 0; game_id < record.games_count; game_id++) {
+        GameRecord game_record = {game_id, getFirstPlayerId(games, game_id), getSecondPlayerId(games, game_id),
+                                  (int) getGameWinner(games, game_id), getDuration(games, game_id)};
+        writeSnapshotBytes(writer, &game_record, sizeof(game_record));
+    }
+    int written = 0;
+    SET_FOREACH(int *, pair, getPlayedPairs(tournament)) {
+        writeSnapshotBytes(writer, pair, sizeof(int) * PAIR_SIZE);
+        free(pair);
+        written++;
+    }
+    if (written != record.pairs_count) {
+        writer->failed = true;
+    }
+}
+
+static bool readSnapshotBytes(SnapshotReader *reader, void *target, size_t size) {
+    if ((size_t) (reader->end - reader->cursor) < size) {
+        return false;
+    }
+    memcpy(target, reader->cursor, size);
+    reader->cursor += size;
+    return true;
+}
+
+/**
+ * Checks that a mapped file is a complete snapshot of this version
+ * @param snapshot - the mapped file
+ * @param size - the size of the file
+ * @param header - the header of the snapshot is stored here
+ * @return CHESS_LOAD_FAILURE if the file is not a valid snapshot, CHESS_SUCCESS otherwise
+ */
+static ChessResult verifySnapshot(const unsigned char *snapshot, size_t size, SnapshotHeader *header) {
+    memcpy(header, snapshot, sizeof(*header));
+    if (header->magic != SNAPSHOT_MAGIC || header->version != SNAPSHOT_VERSION
+        || header->payload_size != size - sizeof(*header)) {
+        return CHESS_LOAD_FAILURE;
+    }
+    uint32_t checksum = hashFnv1a(FNV_OFFSET_BASIS, snapshot + sizeof(*header), size - sizeof(*header));
+    return checksum == header->checksum ? CHESS_SUCCESS : CHESS_LOAD_FAILURE;
+}
+
+static bool readPlayerRecord(SnapshotReader *reader, PlayerRecord *record) {
+    return readSnapshotBytes(reader, record, sizeof(*record)) && checkValidID(record->id);
+}
+
+static void applyPlayerRecord(Player player, const PlayerRecord *record) {
+    updateWins(player, record->wins);
+    updateDraws(player, record->draws);
+    updateLosses(player, record->losses);
+    updatePlayerPlayTime(player, record->play_time);
+    setIsRemoved(player, record->is_removed != 0);
+}
+
+static ChessResult restorePlayer(ChessSystem chess, SnapshotReader *reader, int tournament_id, Map players) {
+    PlayerRecord record;
+    if (!readPlayerRecord(reader, &record)) {
+        return CHESS_LOAD_FAILURE;
+    }
+    Player player = playerCreatePlayer(record.id);
+    if (player == NULL) {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    applyPlayerRecord(player, &record);
+    ChessResult result = convertMapResultToChessResult(mapPut(players, &record.id, player));
+    freeMapData(player);
+    if (result != CHESS_SUCCESS) {
+        return result;
+    }
+    return registerPlayer(chess, tournament_id, record.id);
+}
+
+static ChessResult restoreSystemPlayer(SnapshotReader *reader, PlayerTable players) {
+    PlayerRecord record;
+    if (!readPlayerRecord(reader, &record)) {
+        return CHESS_LOAD_FAILURE;
+    }
+    Player player = playerTableAdd(players, record.id);
+    if (player == NULL) {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    applyPlayerRecord(player, &record);
+    return CHESS_SUCCESS;
+}
+
+/**
+ * Restores a tournament, with its games listed in the player_games index and its players in the player_tournaments
+ * index.
+ * The games are taken as they were saved, without going through the validation of chessAddGame.
+ * @param chess - chess system
+ * @param reader - the snapshot, positioned at the tournament's record
+ * @return CHESS_LOAD_FAILURE if the snapshot is malformed, CHESS_OUT_OF_MEMORY if there was a memory allocation
+ * failure, CHESS_SUCCESS otherwise
+ */
+static ChessResult restoreTournament(ChessSystem chess, SnapshotReader *reader) {
+    TournamentRecord record;
+    if (!readSnapshotBytes(reader, &record, sizeof(record)) || record.location_length <= 0
+        || reader->end - reader->cursor < record.location_length
+        || reader->cursor[record.location_length - 1] != '\0') {
+        return CHESS_LOAD_FAILURE;
+    }
+    // The location is read in place, and the tournament copies it
+    const char *location = (const char *) reader->cursor;
+    reader->cursor += record.location_length;
+    int tournament_id = record.state.id;
+    ChessTournament tournament = createTournament(tournament_id, record.state.max_games_per_player, location);
+    if (tournament == NULL) {
+        return CHESS_OUT_OF_MEMORY;
+    }
+    ChessResult result = convertMapResultToChessResult(mapPut(chess->tournaments, &tournament_id, tournament));
+    freeTournament(tournament);
+    if (result != CHESS_SUCCESS) {
+        return result;
+    }
+    tournament = mapGet(chess->tournaments, &tournament_id);
+    restoreTournamentState(tournament, &record.state);
+
+    for (int i = 0; result == CHESS_SUCCESS && i < record.players_count; i++) {
+        result = restorePlayer(chess, reader, tournament_id, getPlayers(tournament));
+    }
+    for (int i = 0; result == CHESS_SUCCESS && i < record.games_count; i++) {
+        GameRecord game_record;
+        if (!readSnapshotBytes(reader, &game_record, sizeof(game_record))
+            || game_record.winner < FIRST_PLAYER || game_record.winner > DRAW) {
+            return CHESS_LOAD_FAILURE;
+        }
+        // The games are saved in the order of their ids, which are the positions they are stored at
+        if (game_record.id != i) {
+            return CHESS_LOAD_FAILURE;
+        }
+        if (addChessGame(getGames(tournament), game_record.first_player, game_record.second_player,
+                         (Winner) game_record.winner, game_record.duration) != i) {
+            return CHESS_OUT_OF_MEMORY;
+        }
+        result = indexGame(chess, tournament_id, game_record.id, game_record.first_player,
+                           game_record.second_player);
+    }
+    for (int i = 0; result == CHESS_SUCCESS && i < record.pairs_count; i++) {
+        int pair[PAIR_SIZE];
+        if (!readSnapshotBytes(reader, pair, sizeof(pair))) {
+            return CHESS_LOAD_FAILURE;
+        }
+        if (!addPlayedPair(tournament, pair[0], pair[1])) {
+            return CHESS_OUT_OF_MEMORY;
+        }
+    }
+    restoreGameDurations(tournament);
+    return result;
+}
+
+ChessResult chessOpenJournal(ChessSystem chess, const char *path_file, int sync_interval) {
+    if (chess == NULL || path_file == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    // A torn tail is cut off first, as the calls appended after it could not be replayed
+    JournalState state;
+    if (!journalRepair(path_file, &state)) {
+        return state == JOURNAL_CORRUPT ? CHESS_LOAD_FAILURE
+                                        : state == JOURNAL_OUT_OF_MEMORY ? CHESS_OUT_OF_MEMORY : CHESS_SAVE_FAILURE;
+    }
+    ChessJournal journal = journalOpen(path_file, sync_interval);
+    if (journal == NULL) {
+        return CHESS_SAVE_FAILURE;
+    }
+    ChessResult result = chessCloseJournal(chess);
+    chess->journal = journal;
+    return result;
+}
+
+ChessResult chessSyncJournal(ChessSystem chess) {
+    if (chess == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    if (chess->journal != NULL && !journalSync(chess->journal)) {
+        return CHESS_SAVE_FAILURE;
+    }
+    return CHESS_SUCCESS;
+}
+
+ChessResult chessCloseJournal(ChessSystem chess) {
+    if (chess == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    bool succeeded = journalClose(chess->journal);
+    chess->journal = NULL;
+    return succeeded ? CHESS_SUCCESS : CHESS_SAVE_FAILURE;
+}
+
+ChessResult chessCheckpoint(ChessSystem chess, const char *path_file) {
+    if (chess == NULL || path_file == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    ChessResult result = chessSaveSnapshot(chess, path_file);
+    if (result != CHESS_SUCCESS) {
+        return result;
+    }
+    if (chess->journal != NULL && !journalTruncate(chess->journal)) {
+        return CHESS_SAVE_FAILURE;
+    }
+    return CHESS_SUCCESS;
+}
+
+ChessResult chessReplayJournal(ChessSystem chess, const char *path_file) {
+    if (chess == NULL || path_file == NULL) {
+        return CHESS_NULL_ARGUMENT;
+    }
+    JournalReader reader = journalReaderOpen(path_file);
+    if (reader == NULL) {
+        return CHESS_LOAD_FAILURE;
+    }
+    ChessGameInput *games = malloc(sizeof(*games) * JOURNAL_BATCH_SIZE);
+    if (games == NULL) {
+        journalReaderClose(reader);
+        return CHESS_OUT_OF_MEMORY;
+    }
+    // The replayed calls are already in a journal, so they are not journaled again
+    ChessJournal journal = chess->journal;
+    chess->journal = NULL;
+    int games_count = 0, games_tournament = 0;
+    ChessResult result = CHESS_SUCCESS;
+    JournalRecord record;
+    while (result == CHESS_SUCCESS && journalReadRecord(reader, &record)) {
+        result = replayJournalRecord(chess, &record, games, &games_count, &games_tournament);
+    }
+    if (result == CHESS_SUCCESS) {
+        result = flushJournalGames(chess, games, &games_count, games_tournament);
+    }
+    if (result == CHESS_SUCCESS) {
+        switch (journalReaderState(reader)) {
+            case JOURNAL_TORN_TAIL:
+                result = CHESS_JOURNAL_TORN;
+                break;
+            case JOURNAL_CORRUPT:
+                result = CHESS_LOAD_FAILURE;
+                break;
+            case JOURNAL_OUT_OF_MEMORY:
+                result = CHESS_OUT_OF_MEMORY;
+                break;
+            default:
+                break;
+        }
+    }
+    chess->journal = journal;
+    free(games);
+    journalReaderClose(reader);
+    return result;
+}
+
+/**
+ * Appends a successful mutating call to the journal, if the system has one.
+ * A call that can not be written is reported by the next chessSyncJournal or chessCloseJournal.
+ */
+void journalCall(ChessSystem chess, JournalRecordType type, const int *values, int values_count, const char *text) {
+    if (chess->journal == NULL) {
+        return;
+    }
+    JournalRecord record;
+    record.type = type;
+    record.values_count = values_count;
+    for (int i = 0; i < values_count; i++) {
+        record.values[i] = values[i];
+    }
+    record.text = text;
+    journalAppend(chess->journal, &record);
+}
+
+/**
+ * Applies a journal record. Consecutive games of a tournament are collected, and added together by chessAddGames
+ * @param chess - chess system
+ * @param record - the record to apply
+ * @param games - the collected games
+ * @param games_count - the number of collected games
+ * @param games_tournament - the tournament of the collected games
+ * @return CHESS_LOAD_FAILURE if the record is not a valid call, CHESS_OUT_OF_MEMORY if there was a memory allocation
+ * failure, CHESS_SUCCESS otherwise. Calls the system rejects are skipped, as they were not journaled by a
+ * system in the same state.
+ */
+ChessResult replayJournalRecord(ChessSystem chess, const JournalRecord *record, ChessGameInput *games,
+                                int *games_count, int *games_tournament) {
+    if (record->type == JOURNAL_ADD_GAME && record->values_count == JOURNAL_MAX_VALUES) {
+        if (*games_count == JOURNAL_BATCH_SIZE || (*games_count > 0 && *games_tournament != record->values[0])) {
+            ChessResult result = flushJournalGames(chess, games, games_count, *games_tournament);
+            if (result != CHESS_SUCCESS) {
+                return result;
+            }
+        }
+        *games_tournament = record->values[0];
+        ChessGameInput game = {record->values[1], record->values[2], (Winner) record->values[3], record->values[4]};
+        games[(*games_count)++] = game;
+        return CHESS_SUCCESS;
+    }
+    ChessResult result = flushJournalGames(chess, games, games_count, *games_tournament);
+    if (result != CHESS_SUCCESS) {
+        return result;
+    }
+    if (record->type == JOURNAL_ADD_TOURNAMENT && record->values_count == 2) {
+        result = chessAddTournament(chess, record->values[0], record->values[1], record->text);
+    } else if (record->type == JOURNAL_REMOVE_PLAYER && record->values_count == 1) {
+        result = chessRemovePlayer(chess, record->values[0]);
+    } else if (record->type == JOURNAL_REMOVE_TOURNAMENT && record->values_count == 1) {
+        result = chessRemoveTournament(chess, record->values[0]);
+    } else if (record->type == JOURNAL_END_TOURNAMENT && record->values_count == 1) {
+        result = chessEndTournament(chess, record->values[0]);
+    } else {
+        return CHESS_LOAD_FAILURE;
+    }
+    return result == CHESS_OUT_OF_MEMORY ? CHESS_OUT_OF_MEMORY : CHESS_SUCCESS;
+}
+
+ChessResult flushJournalGames(ChessSystem chess, ChessGameInput *games, int *games_count, int games_tournament) {
+    if (*games_count == 0) {
+        return CHESS_SUCCESS;
+    }
+    ChessResult *results = malloc(sizeof(*results) * (size_t) *games_count);
+    if (results == NULL) {
+        return CHESS_OUT_OF_MEMORY;
     }
+    ChessResult result = chessAddGames(chess, games_tournament, games, *games_count, results);
+    free(results);
+    *games_count = 0;
+    return result == CHESS_OUT_OF_MEMORY ? CHESS_OUT_OF_MEMORY : CHESS_SUCCESS;
 }
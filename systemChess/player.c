@@ -110,3 +110,7 @@ Player copyPlayer(Player data) {
     player->play_time = data->play_time;
     return player;
 }
+
+size_t getPlayerMemorySize(){
+    return sizeof(struct player);
+}
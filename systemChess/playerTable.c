@@ -0,0 +1,132 @@
+#include <limits.h>
+#include "headers/playerTable.h"
+
+#define PAGE_BITS 10
+#define DIRECTORY_BITS 10
+#define PAGE_SIZE (1 << PAGE_BITS)
+#define DIRECTORY_SIZE (1 << DIRECTORY_BITS)
+// The root covers every positive int, which has 31 bits
+#define ROOT_SIZE (1 << (31 - PAGE_BITS - DIRECTORY_BITS))
+#define ROOT_INDEX(id) ((id) >> (PAGE_BITS + DIRECTORY_BITS))
+#define DIRECTORY_INDEX(id) (((id) >> PAGE_BITS) & (DIRECTORY_SIZE - 1))
+#define PAGE_INDEX(id) ((id) & (PAGE_SIZE - 1))
+
+struct player_table_t {
+    Player **directories[ROOT_SIZE];
+    int size;
+    int directories_count;
+    int pages_count;
+};
+
+PlayerTable playerTableCreate(){
+    PlayerTable table = malloc(sizeof(*table));
+    if(table == NULL){
+        return NULL;
+    }
+    for(int i = 0; i < ROOT_SIZE; i++){
+        table->directories[i] = NULL;
+    }
+    table->size = 0;
+    table->directories_count = 0;
+    table->pages_count = 0;
+    return table;
+}
+
+void playerTableDestroy(PlayerTable table){
+    if(table == NULL){
+        return;
+    }
+    for(int i = 0; i < ROOT_SIZE; i++){
+        Player **directory = table->directories[i];
+        if(directory == NULL){
+            continue;
+        }
+        for(int j = 0; j < DIRECTORY_SIZE; j++){
+            if(directory[j] == NULL){
+                continue;
+            }
+            for(int k = 0; k < PAGE_SIZE; k++){
+                free(directory[j][k]);
+            }
+            free(directory[j]);
+        }
+        free(directory);
+    }
+    free(table);
+}
+
+int playerTableGetSize(PlayerTable table){
+    return table->size;
+}
+
+Player playerTableGet(PlayerTable table, int player_id){
+    if(player_id <= 0){
+        return NULL;
+    }
+    Player **directory = table->directories[ROOT_INDEX(player_id)];
+    if(directory == NULL){
+        return NULL;
+    }
+    Player *page = directory[DIRECTORY_INDEX(player_id)];
+    return page == NULL ? NULL : page[PAGE_INDEX(player_id)];
+}
+
+Player playerTableAdd(PlayerTable table, int player_id){
+    if(player_id <= 0){
+        return NULL;
+    }
+    Player **directory = table->directories[ROOT_INDEX(player_id)];
+    if(directory == NULL){
+        directory = calloc(DIRECTORY_SIZE, sizeof(*directory));
+        if(directory == NULL){
+            return NULL;
+        }
+        table->directories[ROOT_INDEX(player_id)] = directory;
+        table->directories_count++;
+    }
+    Player *page = directory[DIRECTORY_INDEX(player_id)];
+    if(page == NULL){
+        page = calloc(PAGE_SIZE, sizeof(*page));
+        if(page == NULL){
+            return NULL;
+        }
+        directory[DIRECTORY_INDEX(player_id)] = page;
+        table->pages_count++;
+    }
+    if(page[PAGE_INDEX(player_id)] == NULL){
+        page[PAGE_INDEX(player_id)] = playerCreatePlayer(player_id);
+        if(page[PAGE_INDEX(player_id)] == NULL){
+            return NULL;
+        }
+        table->size++;
+    }
+    return page[PAGE_INDEX(player_id)];
+}
+
+Player playerTableGetNext(PlayerTable table, int player_id){
+    // Missing directories and pages are skipped whole
+    long long id = player_id < 0 ? 1 : (long long) player_id + 1;
+    while(id <= INT_MAX){
+        Player **directory = table->directories[ROOT_INDEX(id)];
+        if(directory == NULL){
+            id = (ROOT_INDEX(id) + 1) << (PAGE_BITS + DIRECTORY_BITS);
+            continue;
+        }
+        Player *page = directory[DIRECTORY_INDEX(id)];
+        if(page == NULL){
+            id = ((id >> PAGE_BITS) + 1) << PAGE_BITS;
+            continue;
+        }
+        if(page[PAGE_INDEX(id)] != NULL){
+            return page[PAGE_INDEX(id)];
+        }
+        id++;
+    }
+    return NULL;
+}
+
+size_t playerTableGetMemoryUsage(PlayerTable table){
+    return sizeof(*table) + (size_t) table->directories_count * DIRECTORY_SIZE * sizeof(Player *)
+           + (size_t) table->pages_count * PAGE_SIZE * sizeof(Player)
+           + (size_t) table->size * getPlayerMemorySize();
+}
@@ -1400,6 +1400,520 @@ bool testPlayerAfterRemoveTournament_Shimon()
 }
 
 
+bool testMemoryStats()
+{
+    ChessSystem chess = chessCreate();
+    ChessMemoryStats empty_stats;
+    ASSERT_TEST(chessGetMemoryStats(chess, NULL) == CHESS_NULL_ARGUMENT);
+    ASSERT_TEST(chessGetMemoryStats(chess, &empty_stats) == CHESS_SUCCESS);
+    ASSERT_TEST(empty_stats.games == 0 && empty_stats.tournament_players == 0);
+
+    ASSERT_TEST(chessAddTournament(chess, 1, 10, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 10, "Paris") == CHESS_SUCCESS);
+    for (int player = 2; player <= 6; ++player) {
+        ASSERT_TEST(chessAddGame(chess, 1, 1, player, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    }
+    ASSERT_TEST(chessAddGame(chess, 2, 1, 2, DRAW, 100) == CHESS_SUCCESS);
+
+    ChessTournamentMemoryStats london, paris;
+    ASSERT_TEST(chessGetTournamentMemoryStats(chess, 1, &london) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentMemoryStats(chess, 2, &paris) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentMemoryStats(chess, 3, &paris) == CHESS_TOURNAMENT_NOT_EXIST);
+    ASSERT_TEST(chessGetTournamentMemoryStats(chess, -1, &paris) == CHESS_INVALID_ID);
+    ASSERT_TEST(london.games > paris.games && london.players > paris.players);
+    ASSERT_TEST(london.total > london.games + london.players);
+
+    ChessMemoryStats stats;
+    ASSERT_TEST(chessGetMemoryStats(chess, &stats) == CHESS_SUCCESS);
+    ASSERT_TEST(stats.games == london.games + paris.games);
+    ASSERT_TEST(stats.tournament_players == london.players + paris.players);
+    ASSERT_TEST(stats.players > empty_stats.players);
+    ASSERT_TEST(stats.indexes > empty_stats.indexes);
+    ASSERT_TEST(stats.total > stats.games + stats.tournament_players + stats.tournaments + stats.players
+                              + stats.indexes);
+
+    ASSERT_TEST(chessRemoveTournament(chess, 1) == CHESS_SUCCESS);
+    ChessMemoryStats after_removal;
+    ASSERT_TEST(chessGetMemoryStats(chess, &after_removal) == CHESS_SUCCESS);
+    ASSERT_TEST(after_removal.games == paris.games);
+    ASSERT_TEST(after_removal.indexes < stats.indexes);
+    ASSERT_TEST(after_removal.total < stats.total);
+    chessDestroy(chess);
+    return true;
+}
+bool testGameExistsAfterPlayerRemoval()
+{
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chessAddTournament(chess, 1, 10, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 1, DRAW, 100) == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 3, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(chess, 1) == CHESS_SUCCESS);
+    // The games of a removed player do not count
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 3, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 1, SECOND_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, DRAW, 100) == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(chessAddGame(chess, 1, 3, 2, DRAW, 100) == CHESS_GAME_ALREADY_EXISTS);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testRemovePlayerAfterTournamentReuse()
+{
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chessAddTournament(chess, 1, 10, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 1, 10, "Paris") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 3, DRAW, 100) == CHESS_SUCCESS);
+    // The games of the removed tournament are no longer player 1's games
+    ASSERT_TEST(chessRemovePlayer(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 3, 2, DRAW, 100) == CHESS_GAME_ALREADY_EXISTS);
+
+    // A rejected game still gives its players profiles, which a loaded snapshot lists under them as well
+    ChessResult result;
+    ASSERT_TEST(chessAddTournament(chess, 2, 10, "Rome") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 4, 5, FIRST_PLAYER, -1) == CHESS_INVALID_PLAY_TIME);
+    ASSERT_TEST(chessAddGame(chess, 2, 2, 4, SECOND_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveSnapshot(chess, "chess_snapshot.bin") == CHESS_SUCCESS);
+    ChessSystem loaded = chessLoadSnapshot("chess_snapshot.bin", &result);
+    remove("chess_snapshot.bin");
+    ASSERT_TEST(loaded != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(loaded, 5) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveTournament(loaded, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(loaded, 4) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentLeader(loaded, 1, &result) == 2 && result == CHESS_SUCCESS);
+    chessDestroy(loaded);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testTournamentLeader()
+{
+    ChessSystem chess = chessCreate();
+    ChessResult result;
+    ASSERT_TEST(chessAddTournament(chess, 1, 10, "London") == CHESS_SUCCESS);
+    chessGetTournamentLeader(chess, 1, &result);
+    ASSERT_TEST(result == CHESS_NO_GAMES);
+    ASSERT_TEST(chessAddGame(chess, 1, 3, 2, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentLeader(chess, 1, &result) == 3 && result == CHESS_SUCCESS);
+    // 1 and 3 have the same score and losses, 3 has more wins
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 4, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 5, DRAW, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentLeader(chess, 1, &result) == 3);
+    // Removing 3 gives his game to 2, who now ties with 1 and has more wins
+    ASSERT_TEST(chessRemovePlayer(chess, 3) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentLeader(chess, 1, &result) == 2);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 6, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentLeader(chess, 1, &result) == 1);
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentLeader(chess, 1, &result) == 1 && result == CHESS_SUCCESS);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testPlayersLeaderboard()
+{
+    ChessSystem chess = chessCreate();
+    ChessResult result;
+    int top[3] = {0};
+    ASSERT_TEST(chessGetTopPlayers(chess, 3, top, &result) == 0 && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 1, 10, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 3, 4, DRAW, 100) == CHESS_SUCCESS);
+    // Levels: 1 -> 6, 3 and 4 -> 2, 2 -> -10
+    ASSERT_TEST(chessGetTopPlayers(chess, 3, top, &result) == 3 && result == CHESS_SUCCESS);
+    ASSERT_TEST(top[0] == 1 && top[1] == 3 && top[2] == 4);
+    ASSERT_TEST(chessGetPlayerRank(chess, 2, &result) == 4 && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 4, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    // Levels: 1 -> 6, 3 -> 2, 2 -> -2, 4 -> -4
+    ASSERT_TEST(chessGetPlayerRank(chess, 2, &result) == 3);
+    ASSERT_TEST(chessGetPlayerRank(chess, 4, &result) == 4);
+    ASSERT_TEST(chessRemovePlayer(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetPlayerRank(chess, 1, &result) == 0 && result == CHESS_PLAYER_NOT_EXIST);
+    // 2 is given the win of his game with 1, to 6 in two games
+    ASSERT_TEST(chessGetPlayerRank(chess, 2, &result) == 1);
+    ASSERT_TEST(chessRemoveTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTopPlayers(chess, 3, top, &result) == 0);
+    ASSERT_TEST(chessGetPlayerRank(chess, 2, &result) == 0 && result == CHESS_SUCCESS);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testAddGames()
+{
+    ChessSystem chess = chessCreate();
+    ChessSystem single = chessCreate();
+    ChessGameInput games[] = {
+            {1, 2, FIRST_PLAYER, 100},
+            {2, 3, DRAW, 50},
+            {2, 1, SECOND_PLAYER, 10},
+            {3, 3, DRAW, 10},
+            {3, 4, SECOND_PLAYER, -1},
+            {4, 1, FIRST_PLAYER, 70},
+            {1, 3, DRAW, 20},
+    };
+    ChessResult expected[] = {CHESS_SUCCESS, CHESS_SUCCESS, CHESS_GAME_ALREADY_EXISTS, CHESS_INVALID_ID,
+                              CHESS_INVALID_PLAY_TIME, CHESS_SUCCESS, CHESS_EXCEEDED_GAMES};
+    ChessResult results[7];
+    ASSERT_TEST(chessAddGames(chess, 1, games, 7, results) == CHESS_TOURNAMENT_NOT_EXIST);
+    ASSERT_TEST(results[0] == CHESS_TOURNAMENT_NOT_EXIST);
+    ASSERT_TEST(chessAddTournament(chess, 1, 2, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(single, 1, 2, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGames(chess, 1, games, 7, results) == CHESS_SUCCESS);
+    for (int i = 0; i < 7; i++) {
+        ASSERT_TEST(results[i] == expected[i]);
+        ASSERT_TEST(chessAddGame(single, 1, games[i].first_player, games[i].second_player, games[i].winner,
+                                 games[i].play_time) == expected[i]);
+    }
+    int top[4], single_top[4];
+    ChessResult result;
+    ASSERT_TEST(chessGetTopPlayers(chess, 4, top, &result) == 4);
+    ASSERT_TEST(chessGetTopPlayers(single, 4, single_top, &result) == 4);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TEST(top[i] == single_top[i]);
+    }
+    ASSERT_TEST(chessGetTournamentLeader(chess, 1, &result) == chessGetTournamentLeader(single, 1, &result));
+    chessDestroy(chess);
+    chessDestroy(single);
+    return true;
+}
+
+typedef struct {
+    long error_lines[8];
+    ChessResult errors[8];
+    int errors_count;
+    long records;
+} LoadReport;
+
+static void recordLoadError(long line_number, ChessResult error, void *context)
+{
+    LoadReport *report = context;
+    if (report->errors_count < 8) {
+        report->error_lines[report->errors_count] = line_number;
+        report->errors[report->errors_count] = error;
+    }
+    report->errors_count++;
+}
+
+static void recordLoadProgress(long records, void *context)
+{
+    ((LoadReport *) context)->records = records;
+}
+
+bool testLoadFromStream()
+{
+    ChessSystem chess = chessCreate();
+    FILE *stream = tmpfile();
+    ASSERT_TEST(stream != NULL);
+    fputs("# tournaments and games\n"
+          "T,1,2,London\n"
+          "G,1,1,2,0,100\n"
+          "G,1,2,3,2,50\r\n"
+          "\n"
+          "G,1,2,1,1,10\n"
+          "G,1,3,4,x,10\n"
+          "T,2,5,paris\n"
+          "G,2,1,2,1,30\n"
+          "G,1,1,3,2,20", stream);
+    rewind(stream);
+    LoadReport report = {{0}, {0}, 0, 0};
+    ChessLoadHandlers handlers = {recordLoadError, recordLoadProgress, &report};
+    ASSERT_TEST(chessLoadFromStream(chess, NULL, &handlers) == CHESS_NULL_ARGUMENT);
+    ASSERT_TEST(chessLoadFromStream(chess, stream, &handlers) == CHESS_SUCCESS);
+    fclose(stream);
+    ASSERT_TEST(report.records == 8);
+    ASSERT_TEST(report.errors_count == 4);
+    // Games are reported when their batch is added, after the malformed line that follows them
+    ASSERT_TEST(report.error_lines[0] == 7 && report.errors[0] == CHESS_LOAD_FAILURE);
+    ASSERT_TEST(report.error_lines[1] == 6 && report.errors[1] == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(report.error_lines[2] == 8 && report.errors[2] == CHESS_INVALID_LOCATION);
+    ASSERT_TEST(report.error_lines[3] == 9 && report.errors[3] == CHESS_TOURNAMENT_NOT_EXIST);
+    // The last line has no line break, and was loaded too
+    ChessResult result;
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 3, DRAW, 20) == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, 1, &result) == 60 && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessLoadFromFile(chess, "no_such_directory/games.csv", NULL) == CHESS_LOAD_FAILURE);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testSnapshot()
+{
+    ChessSystem chess = chessCreate();
+    ChessResult result;
+    ASSERT_TEST(chessAddTournament(chess, 1, 4, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 4, "Paris") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 3, DRAW, 50) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 2, 3, 4, SECOND_PLAYER, 70) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveSnapshot(chess, "chess_snapshot.bin") == CHESS_SUCCESS);
+
+    ChessSystem loaded = chessLoadSnapshot("chess_snapshot.bin", &result);
+    ASSERT_TEST(loaded != NULL && result == CHESS_SUCCESS);
+    int top[4], loaded_top[4];
+    ASSERT_TEST(chessGetTopPlayers(chess, 4, top, &result) == 3);
+    ASSERT_TEST(chessGetTopPlayers(loaded, 4, loaded_top, &result) == 3);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TEST(top[i] == loaded_top[i]);
+    }
+    ASSERT_TEST(chessCalculateAveragePlayTime(loaded, 3, &result) == 60 && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentLeader(loaded, 2, &result) == 4);
+    ASSERT_TEST(chessGetTournamentLeader(loaded, 1, &result) == chessGetTournamentLeader(chess, 1, &result));
+    // The duration statistics are rebuilt from the restored games
+    char statistics[256], loaded_statistics[256];
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chess_statistics.txt") == CHESS_SUCCESS);
+    FILE *statistics_file = fopen("chess_statistics.txt", "r");
+    size_t statistics_size = fread(statistics, 1, sizeof(statistics), statistics_file);
+    fclose(statistics_file);
+    ASSERT_TEST(chessSaveTournamentStatistics(loaded, "chess_statistics.txt") == CHESS_SUCCESS);
+    statistics_file = fopen("chess_statistics.txt", "r");
+    ASSERT_TEST(fread(loaded_statistics, 1, sizeof(loaded_statistics), statistics_file) == statistics_size);
+    fclose(statistics_file);
+    remove("chess_statistics.txt");
+    ASSERT_TEST(statistics_size > 0 && memcmp(statistics, loaded_statistics, statistics_size) == 0);
+    ASSERT_TEST(chessAddGame(loaded, 2, 1, 3, DRAW, 10) == CHESS_TOURNAMENT_ENDED);
+    ASSERT_TEST(chessAddGame(loaded, 1, 3, 2, DRAW, 10) == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(chessAddGame(loaded, 1, 2, 1, DRAW, 10) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(loaded, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(loaded, 1) == CHESS_SUCCESS);
+    chessDestroy(loaded);
+
+    // A damaged snapshot is rejected
+    FILE *file = fopen("chess_snapshot.bin", "r+b");
+    ASSERT_TEST(file != NULL);
+    ASSERT_TEST(fseek(file, -1, SEEK_END) == 0);
+    int last = fgetc(file);
+    ASSERT_TEST(fseek(file, -1, SEEK_END) == 0);
+    fputc(last ^ 1, file);
+    fclose(file);
+    ASSERT_TEST(chessLoadSnapshot("chess_snapshot.bin", &result) == NULL && result == CHESS_LOAD_FAILURE);
+    remove("chess_snapshot.bin");
+    ASSERT_TEST(chessLoadSnapshot("chess_snapshot.bin", &result) == NULL && result == CHESS_LOAD_FAILURE);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testJournal()
+{
+    remove("chess_journal.bin");
+    ChessSystem chess = chessCreate();
+    ChessResult result;
+    ASSERT_TEST(chessOpenJournal(chess, "chess_journal.bin", 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 1, 4, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(chess, 2, 4, "Paris") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, 2, FIRST_PLAYER, 100) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 3, DRAW, 50) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 2, 3, DRAW, 50) == CHESS_GAME_ALREADY_EXISTS);
+    ASSERT_TEST(chessAddGame(chess, 2, 3, 4, SECOND_PLAYER, 70) == CHESS_SUCCESS);
+    ASSERT_TEST(chessEndTournament(chess, 2) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSyncJournal(chess) == CHESS_SUCCESS);
+
+    // Replaying the journal into an empty system repeats the calls
+    ChessSystem replayed = chessCreate();
+    ASSERT_TEST(chessReplayJournal(replayed, "chess_journal.bin") == CHESS_SUCCESS);
+    int top[4], replayed_top[4];
+    ASSERT_TEST(chessGetTopPlayers(chess, 4, top, &result) == 3);
+    ASSERT_TEST(chessGetTopPlayers(replayed, 4, replayed_top, &result) == 3);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TEST(top[i] == replayed_top[i]);
+    }
+    ASSERT_TEST(chessGetTournamentLeader(replayed, 2, &result) == 4);
+    ASSERT_TEST(chessAddGame(replayed, 2, 1, 3, DRAW, 10) == CHESS_TOURNAMENT_ENDED);
+    chessDestroy(replayed);
+
+    // After a checkpoint, the snapshot and the calls journaled since restore the system
+    ASSERT_TEST(chessCheckpoint(chess, "chess_snapshot.bin") == CHESS_SUCCESS);
+    // The snapshot was renamed into place, so no temporary file is left behind
+    FILE *temporary = fopen("chess_snapshot.bin.tmp", "rb");
+    ASSERT_TEST(temporary == NULL);
+    ASSERT_TEST(chessAddTournament(chess, 3, 2, "Rome") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 4, 5, FIRST_PLAYER, 30) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemoveTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessCloseJournal(chess) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 3, 4, 6, FIRST_PLAYER, 30) == CHESS_SUCCESS);
+    replayed = chessLoadSnapshot("chess_snapshot.bin", &result);
+    ASSERT_TEST(replayed != NULL && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessReplayJournal(replayed, "chess_journal.bin") == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentLeader(replayed, 3, &result) == 4);
+    ASSERT_TEST(chessGetTournamentLeader(replayed, 1, &result) == 0 && result == CHESS_TOURNAMENT_NOT_EXIST);
+    ASSERT_TEST(chessCalculateAveragePlayTime(replayed, 4, &result) == 50 && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessCalculateAveragePlayTime(replayed, 6, &result) == 0 && result == CHESS_PLAYER_NOT_EXIST);
+    chessDestroy(replayed);
+
+    // A journal cut short by a crash is replayed up to its torn tail
+    char journal[256];
+    FILE *file = fopen("chess_journal.bin", "rb");
+    ASSERT_TEST(file != NULL);
+    size_t size = fread(journal, 1, sizeof(journal), file);
+    fclose(file);
+    ASSERT_TEST(size > 0 && size < sizeof(journal));
+    file = fopen("chess_journal.bin", "wb");
+    ASSERT_TEST(file != NULL);
+    ASSERT_TEST(fwrite(journal, 1, size - 1, file) == size - 1);
+    fclose(file);
+    replayed = chessLoadSnapshot("chess_snapshot.bin", &result);
+    ASSERT_TEST(chessReplayJournal(replayed, "chess_journal.bin") == CHESS_JOURNAL_TORN);
+    ASSERT_TEST(chessGetTournamentLeader(replayed, 3, &result) == 4);
+    ASSERT_TEST(chessGetTournamentLeader(replayed, 1, &result) != 0 && result == CHESS_SUCCESS);
+
+    // Reopening the journal cuts the torn tail off, so the calls appended next are replayed after the others
+    ASSERT_TEST(chessOpenJournal(replayed, "chess_journal.bin", 0) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddTournament(replayed, 4, 2, "Madrid") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(replayed, 4, 5, 6, SECOND_PLAYER, 20) == CHESS_SUCCESS);
+    ASSERT_TEST(chessCloseJournal(replayed) == CHESS_SUCCESS);
+    chessDestroy(replayed);
+    replayed = chessLoadSnapshot("chess_snapshot.bin", &result);
+    ASSERT_TEST(chessReplayJournal(replayed, "chess_journal.bin") == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentLeader(replayed, 3, &result) == 4);
+    ASSERT_TEST(chessGetTournamentLeader(replayed, 1, &result) != 0 && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessGetTournamentLeader(replayed, 4, &result) == 6 && result == CHESS_SUCCESS);
+    chessDestroy(replayed);
+
+    // The header has its own checksum, so a record whose type was damaged is not replayed, even as the last one.
+    // The last record removes tournament 1: a 16 byte header, whose type follows a 4 byte length and two
+    // 4 byte checksums, and one value. The damage turns it into ending tournament 1.
+    journal[size - 8] ^= 1;
+    file = fopen("chess_journal.bin", "wb");
+    ASSERT_TEST(file != NULL);
+    ASSERT_TEST(fwrite(journal, 1, size, file) == size);
+    fclose(file);
+    replayed = chessLoadSnapshot("chess_snapshot.bin", &result);
+    ASSERT_TEST(chessReplayJournal(replayed, "chess_journal.bin") == CHESS_LOAD_FAILURE);
+    ASSERT_TEST(chessAddGame(replayed, 1, 7, 8, DRAW, 10) == CHESS_SUCCESS);
+    chessDestroy(replayed);
+
+    // A damaged length can not pass for a torn tail, so the records after it are not cut off on reopening
+    journal[size - 8] ^= 1;
+    int length = 100000, saved_length;
+    memcpy(&saved_length, journal, sizeof(saved_length));
+    memcpy(journal, &length, sizeof(length));
+    file = fopen("chess_journal.bin", "wb");
+    ASSERT_TEST(file != NULL);
+    ASSERT_TEST(fwrite(journal, 1, size, file) == size);
+    fclose(file);
+    replayed = chessLoadSnapshot("chess_snapshot.bin", &result);
+    ASSERT_TEST(chessReplayJournal(replayed, "chess_journal.bin") == CHESS_LOAD_FAILURE);
+    ASSERT_TEST(chessOpenJournal(replayed, "chess_journal.bin", 0) == CHESS_LOAD_FAILURE);
+    file = fopen("chess_journal.bin", "rb");
+    ASSERT_TEST(file != NULL && fseek(file, 0, SEEK_END) == 0 && ftell(file) == (long) size);
+    fclose(file);
+    chessDestroy(replayed);
+
+    // A damaged payload followed by other records is corruption, and the journal can not be reopened
+    memcpy(journal, &saved_length, sizeof(saved_length));
+    journal[16] ^= 1;
+    file = fopen("chess_journal.bin", "wb");
+    ASSERT_TEST(file != NULL);
+    ASSERT_TEST(fwrite(journal, 1, size, file) == size);
+    fclose(file);
+    replayed = chessLoadSnapshot("chess_snapshot.bin", &result);
+    ASSERT_TEST(chessReplayJournal(replayed, "chess_journal.bin") == CHESS_LOAD_FAILURE);
+    ASSERT_TEST(chessGetTournamentLeader(replayed, 3, &result) == 0 && result == CHESS_TOURNAMENT_NOT_EXIST);
+    ASSERT_TEST(chessOpenJournal(replayed, "chess_journal.bin", 0) == CHESS_LOAD_FAILURE);
+    chessDestroy(replayed);
+    remove("chess_journal.bin");
+    remove("chess_snapshot.bin");
+    ASSERT_TEST(chessReplayJournal(chess, "chess_journal.bin") == CHESS_LOAD_FAILURE);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testSnapshotDurations()
+{
+    ChessSystem chess = chessCreate();
+    ChessResult result;
+    ASSERT_TEST(chessAddTournament(chess, 1, 20, "London") == CHESS_SUCCESS);
+    for (int player = 2; player <= 20; player++) {
+        ASSERT_TEST(chessAddGame(chess, 1, 1, player, DRAW, (player * 37) % 101) == CHESS_SUCCESS);
+    }
+    ASSERT_TEST(chessEndTournament(chess, 1) == CHESS_SUCCESS);
+    ASSERT_TEST(chessSaveSnapshot(chess, "chess_snapshot.bin") == CHESS_SUCCESS);
+    ChessSystem loaded = chessLoadSnapshot("chess_snapshot.bin", &result);
+    remove("chess_snapshot.bin");
+    ASSERT_TEST(loaded != NULL && result == CHESS_SUCCESS);
+
+    char statistics[256], loaded_statistics[256];
+    ASSERT_TEST(chessSaveTournamentStatistics(chess, "chess_statistics.txt") == CHESS_SUCCESS);
+    FILE *file = fopen("chess_statistics.txt", "r");
+    size_t size = fread(statistics, 1, sizeof(statistics), file);
+    fclose(file);
+    ASSERT_TEST(chessSaveTournamentStatistics(loaded, "chess_statistics.txt") == CHESS_SUCCESS);
+    file = fopen("chess_statistics.txt", "r");
+    ASSERT_TEST(fread(loaded_statistics, 1, sizeof(loaded_statistics), file) == size);
+    fclose(file);
+    remove("chess_statistics.txt");
+    ASSERT_TEST(size > 0 && memcmp(statistics, loaded_statistics, size) == 0);
+    chessDestroy(loaded);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testSparsePlayerIds()
+{
+    ChessSystem chess = chessCreate();
+    ChessResult result;
+    const int max_id = 2147483647;
+    ASSERT_TEST(chessAddTournament(chess, 1, 10, "London") == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1023, 1024, FIRST_PLAYER, 10) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1048576, max_id, SECOND_PLAYER, 20) == CHESS_SUCCESS);
+    ASSERT_TEST(chessAddGame(chess, 1, 1, max_id, DRAW, 30) == CHESS_SUCCESS);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, max_id, &result) == 25 && result == CHESS_SUCCESS);
+    ASSERT_TEST(chessCalculateAveragePlayTime(chess, 1025, &result) == 0 && result == CHESS_PLAYER_NOT_EXIST);
+    int top[5];
+    ASSERT_TEST(chessGetTopPlayers(chess, 5, top, &result) == 5 && result == CHESS_SUCCESS);
+    ASSERT_TEST(top[0] == 1023 && top[1] == max_id);
+    ASSERT_TEST(chessRemovePlayer(chess, max_id) == CHESS_SUCCESS);
+    ASSERT_TEST(chessRemovePlayer(chess, max_id) == CHESS_PLAYER_NOT_EXIST);
+    ASSERT_TEST(chessGetPlayerRank(chess, 1, &result) == 1 && result == CHESS_SUCCESS);
+    chessDestroy(chess);
+    return true;
+}
+
+bool testSavePlayersLevelsParallel()
+{
+    ChessSystem chess = chessCreate();
+    ASSERT_TEST(chessAddTournament(chess, 1, 200, "London") == CHESS_SUCCESS);
+    for (int player = 1; player <= 300; player++) {
+        Winner winner = player % 3 == 0 ? FIRST_PLAYER : (player % 3 == 1 ? SECOND_PLAYER : DRAW);
+        ASSERT_TEST(chessAddGame(chess, 1, player, player + 1, winner, 10) == CHESS_SUCCESS);
+        ASSERT_TEST(chessAddGame(chess, 1, player, (player * 7) % 300 + 302, DRAW, 10) == CHESS_SUCCESS);
+    }
+    for (int player = 5; player <= 300; player += 50) {
+        ASSERT_TEST(chessRemovePlayer(chess, player) == CHESS_SUCCESS);
+    }
+    ASSERT_TEST(chessSavePlayersLevelsParallel(NULL, stdout, 2) == CHESS_NULL_ARGUMENT);
+
+    static char expected[32768], actual[32768];
+    FILE *file = tmpfile();
+    ASSERT_TEST(chessSavePlayersLevels(chess, file) == CHESS_SUCCESS);
+    rewind(file);
+    size_t expected_size = fread(expected, 1, sizeof(expected), file);
+    fclose(file);
+    ASSERT_TEST(expected_size > 0 && expected_size < sizeof(expected));
+    int threads[] = {1, 2, 3, 8, 1000};
+    for (int i = 0; i < (int) (sizeof(threads) / sizeof(*threads)); i++) {
+        file = tmpfile();
+        ASSERT_TEST(chessSavePlayersLevelsParallel(chess, file, threads[i]) == CHESS_SUCCESS);
+        rewind(file);
+        size_t actual_size = fread(actual, 1, sizeof(actual), file);
+        fclose(file);
+        ASSERT_TEST(actual_size == expected_size && memcmp(actual, expected, expected_size) == 0);
+    }
+    chessDestroy(chess);
+
+    // With no players, nothing is printed
+    chess = chessCreate();
+    file = tmpfile();
+    ASSERT_TEST(chessSavePlayersLevelsParallel(chess, file, 4) == CHESS_SUCCESS);
+    ASSERT_TEST(ftell(file) == 0);
+    fclose(file);
+    chessDestroy(chess);
+    return true;
+}
 
 /*The functions for the tests should be added here*/
 bool (*tests[]) (void) = {
@@ -1429,6 +1943,18 @@ bool (*tests[]) (void) = {
         oneMoreTestJustYouKnowToMakeSureEveryThingWorksFine_maaroof,
         testTournamentWinner_maaroof,
         testPlayerLevelsAdvanced_maaroof,
+        testMemoryStats,
+        testGameExistsAfterPlayerRemoval,
+        testRemovePlayerAfterTournamentReuse,
+        testTournamentLeader,
+        testPlayersLeaderboard,
+        testAddGames,
+        testLoadFromStream,
+        testSnapshot,
+        testJournal,
+        testSnapshotDurations,
+        testSparsePlayerIds,
+        testSavePlayersLevelsParallel,
 };
 
 #define NUMBER_TESTS ((long)(sizeof(tests)/sizeof(*tests)))
@@ -1461,6 +1987,18 @@ const char* testNames[NUMBER_TESTS] = {
         "oneMoreTestJustYouKnowToMakeSureEveryThingWorksFine_maaroof",
         "testTournamentWinner_maaroof",
         "testPlayerLevelsAdvanced_maaroof",
+        "testMemoryStats",
+        "testGameExistsAfterPlayerRemoval",
+        "testRemovePlayerAfterTournamentReuse",
+        "testTournamentLeader",
+        "testPlayersLeaderboard",
+        "testAddGames",
+        "testLoadFromStream",
+        "testSnapshot",
+        "testJournal",
+        "testSnapshotDurations",
+        "testSparsePlayerIds",
+        "testSavePlayersLevelsParallel",
 };
 
 